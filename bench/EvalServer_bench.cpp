@@ -0,0 +1,185 @@
+#include "../server/EvalServer.h"
+#include "../server/Protocol.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace poker;
+
+// Local load generator for EvalServer: a client pipelines requests over a
+// socketpair to a server thread, keeping up to `window` requests in flight.
+// The socket scenarios split the same workload across concurrent clients of
+// serveUnixSocket, whose frames the server batches together.
+
+namespace {
+
+std::vector<Request> makeWorkload(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> deck(52);
+    for (uint8_t i = 0; i < 52; ++i) deck[i] = i;
+
+    std::vector<Request> requests(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::shuffle(deck.begin(), deck.end(), rng);
+        Request& request = requests[i];
+        request.id = static_cast<uint32_t>(i);
+        uint32_t kind = rng() % 100;
+        if (kind < 85) {
+            request.op = Op::EVALUATE;
+            request.cardCount = 7;
+        } else if (kind < 97) {
+            request.op = Op::COMPARE;
+            request.cardCount = 9;
+        } else {
+            request.op = Op::EQUITY;      // Turn equity: 44 runouts
+            request.cardCount = 8;
+        }
+        std::copy(deck.begin(), deck.begin() + request.cardCount, request.cards);
+    }
+    return requests;
+}
+
+// Returns requests per second
+double runClient(int fd, const std::vector<Request>& requests, size_t window) {
+    std::vector<uint8_t> out;
+    std::vector<uint8_t> in;
+    std::vector<uint8_t> chunk(64 * 1024);
+    size_t sent = 0;
+    size_t received = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    while (received < requests.size()) {
+        out.clear();
+        while (sent < requests.size() && sent - received < window) {
+            Protocol::encodeRequest(requests[sent++], out);
+        }
+        if (!out.empty() && write(fd, out.data(), out.size()) != ssize_t(out.size())) {
+            std::perror("write");
+            return 0.0;
+        }
+
+        ssize_t n = read(fd, chunk.data(), chunk.size());
+        if (n <= 0) {
+            std::perror("read");
+            return 0.0;
+        }
+        in.insert(in.end(), chunk.begin(), chunk.begin() + n);
+
+        size_t offset = 0;
+        Response response;
+        while (size_t used = Protocol::decodeResponse(in.data() + offset, in.size() - offset,
+                                                      response)) {
+            offset += used;
+            ++received;
+        }
+        in.erase(in.begin(), in.begin() + offset);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return requests.size() / elapsed.count();
+}
+
+void runScenario(const char* name, const std::vector<Request>& requests, size_t window,
+                 size_t passes) {
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        std::perror("socketpair");
+        return;
+    }
+
+    EvalServer server;
+    std::thread worker([&]() {
+        server.serveStream(fds[1], fds[1]);
+        close(fds[1]);
+    });
+
+    double rate = 0.0;
+    for (size_t pass = 0; pass < passes; ++pass) {
+        rate = runClient(fds[0], requests, window);
+    }
+    shutdown(fds[0], SHUT_WR);
+    worker.join();
+    close(fds[0]);
+
+    const ServerStats& stats = server.stats();
+    std::printf("%-28s window=%-5zu %10.0f req/s  batches=%-7llu cacheHits=%llu\n",
+                name, window, rate, static_cast<unsigned long long>(stats.batches),
+                static_cast<unsigned long long>(stats.cacheHits));
+}
+
+int connectTo(const std::string& path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path.c_str());
+
+    // The server thread may not be listening yet
+    for (int attempt = 0; attempt < 1000; ++attempt) {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+        if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) return fd;
+        close(fd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return -1;
+}
+
+void runSocketScenario(const char* name, const std::vector<Request>& requests,
+                       size_t clients, size_t window) {
+    std::string path = "/tmp/eval_server_bench_" + std::to_string(getpid()) + ".sock";
+    EvalServer server;
+    std::thread worker([&]() { server.serveUnixSocket(path); });
+
+    std::vector<std::vector<Request>> slices(clients);
+    for (size_t i = 0; i < requests.size(); ++i) {
+        slices[i % clients].push_back(requests[i]);
+    }
+    std::vector<int> fds(clients);
+    for (auto& fd : fds) {
+        fd = connectTo(path);
+        if (fd < 0) std::perror("connect");
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t c = 0; c < clients; ++c) {
+        if (fds[c] < 0) continue;
+        threads.emplace_back([&, c]() { runClient(fds[c], slices[c], window); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    for (int fd : fds) {
+        if (fd >= 0) close(fd);
+    }
+    server.stop();
+    worker.join();
+
+    const ServerStats& stats = server.stats();
+    std::printf("%-28s clients=%-4zu window=%-5zu %10.0f req/s  batches=%llu\n",
+                name, clients, window, requests.size() / elapsed.count(),
+                static_cast<unsigned long long>(stats.batches));
+}
+
+} // namespace
+
+int main() {
+    auto requests = makeWorkload(20000, 42);
+
+    std::cout << "EvalServer load (" << requests.size() << " requests per pass)\n";
+    runScenario("unpipelined, cold cache", requests, 1, 1);
+    runScenario("pipelined, cold cache", requests, 64, 1);
+    runScenario("pipelined, cold cache", requests, 1024, 1);
+    runScenario("pipelined, warm cache", requests, 1024, 2);
+    runSocketScenario("unix socket, cold cache", requests, 1, 64);
+    runSocketScenario("unix socket, cold cache", requests, 8, 64);
+    runSocketScenario("unix socket, cold cache", requests, 32, 64);
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include "../game/HandEvaluation.h"
+#include "../game/VariantEvaluation.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+
+using namespace poker;
+
+// Reference evaluator throughput on random 7-card hands, next to the packed
+// VariantEvaluator score path for scale.
+
+namespace {
+
+struct Deal {
+    std::vector<Card> hole;
+    std::vector<Card> community;
+};
+
+std::vector<Deal> makeDeals(size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> deck(52);
+    for (uint8_t i = 0; i < 52; ++i) deck[i] = i;
+
+    std::vector<Deal> deals(count);
+    for (auto& deal : deals) {
+        std::shuffle(deck.begin(), deck.end(), rng);
+        for (size_t i = 0; i < 2; ++i) deal.hole.push_back(Card::fromIndex(deck[i]));
+        for (size_t i = 2; i < 7; ++i) deal.community.push_back(Card::fromIndex(deck[i]));
+    }
+    return deals;
+}
+
+template <typename Eval>
+void runScenario(const char* name, const std::vector<Deal>& deals, size_t passes, Eval eval) {
+    unsigned sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t pass = 0; pass < passes; ++pass) {
+        for (const auto& deal : deals) {
+            sink += eval(deal);
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::printf("%-28s %12.0f hands/s  (checksum %u)\n", name,
+                deals.size() * passes / elapsed.count(), sink);
+}
+
+} // namespace
+
+int main() {
+    auto deals = makeDeals(200000, 42);
+
+    std::cout << "Hand evaluation (" << deals.size() << " 7-card hands per pass)\n";
+    runScenario("HandEvaluator::evaluate", deals, 5, [](const Deal& deal) {
+        return static_cast<unsigned>(HandEvaluator::evaluate(deal.hole, deal.community).rank);
+    });
+    runScenario("HoldemEvaluator::score", deals, 5, [](const Deal& deal) {
+        return static_cast<unsigned>(HoldemEvaluator::score(deal.hole, deal.community) >> 20);
+    });
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include "BatchEvaluator.h"
+#include "VariantEvaluation.h"
+#include <stdexcept>
+
+namespace poker {
+
+namespace {
+
+// Walk every way to complete the board with `remaining` live cards above
+// `from`, scoring both hands on each complete runout
+void enumerateRunouts(uint8_t* hand1, uint8_t* hand2, size_t filled,
+                      uint64_t dead, uint8_t from, EquityResult& result) {
+    if (filled == 7) {
+        uint32_t score1 = HoldemEvaluator::scoreIndices(hand1, 7);
+        uint32_t score2 = HoldemEvaluator::scoreIndices(hand2, 7);
+        if (score1 > score2) ++result.wins;
+        else if (score1 < score2) ++result.losses;
+        else ++result.ties;
+        return;
+    }
+    for (uint8_t card = from; card < 52; ++card) {
+        if (dead & (uint64_t(1) << card)) continue;
+        hand1[filled] = card;
+        hand2[filled] = card;
+        enumerateRunouts(hand1, hand2, filled + 1, dead, card + 1, result);
+    }
+}
+
+void checkIndices(const uint8_t* cards, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        if (cards[i] >= 52) throw std::invalid_argument("Card index must be 0-51");
+    }
+}
+
+} // namespace
+
+double EquityResult::equity() const {
+    uint32_t total = wins + ties + losses;
+    return total ? (wins + 0.5 * ties) / total : 0.0;
+}
+
+uint32_t BatchEvaluator::score(const uint8_t* cards, size_t count) {
+    if (count < 5 || count > 7) {
+        throw std::invalid_argument("Need 5-7 cards to evaluate");
+    }
+    checkIndices(cards, count);
+    return HoldemEvaluator::scoreIndices(cards, count);
+}
+
+void BatchEvaluator::scoreBatch(const HandCards* hands, size_t count, uint32_t* scores) {
+    for (size_t i = 0; i < count; ++i) {
+        if (hands[i].count < 5 || hands[i].count > 7) {
+            throw std::invalid_argument("Need 5-7 cards to evaluate");
+        }
+        checkIndices(hands[i].cards, hands[i].count);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        scores[i] = HoldemEvaluator::scoreIndices(hands[i].cards, hands[i].count);
+    }
+}
+
+CompareResult BatchEvaluator::compare(const uint8_t* hole1, const uint8_t* hole2,
+                                      const uint8_t* board) {
+    uint8_t hand1[7] = {hole1[0], hole1[1], board[0], board[1], board[2], board[3], board[4]};
+    uint8_t hand2[7] = {hole2[0], hole2[1], board[0], board[1], board[2], board[3], board[4]};
+    checkIndices(hand1, 7);
+    checkIndices(hand2, 2);
+    uint64_t used = (uint64_t(1) << hole2[0]) | (uint64_t(1) << hole2[1]);
+    for (uint8_t card : hand1) {
+        used |= uint64_t(1) << card;
+    }
+    if (__builtin_popcountll(used) != 9) {
+        throw std::invalid_argument("Duplicate cards in compare request");
+    }
+
+    uint32_t score1 = HoldemEvaluator::scoreIndices(hand1, 7);
+    uint32_t score2 = HoldemEvaluator::scoreIndices(hand2, 7);
+
+    if (score1 > score2) return CompareResult::HAND1_WINS;
+    if (score1 < score2) return CompareResult::HAND2_WINS;
+    return CompareResult::TIE;
+}
+
+EquityResult BatchEvaluator::equity(const uint8_t* hole1, const uint8_t* hole2,
+                                    const uint8_t* board, size_t boardSize) {
+    if (boardSize > 5) {
+        throw std::invalid_argument("Board has at most 5 cards");
+    }
+
+    uint8_t hand1[7] = {hole1[0], hole1[1]};
+    uint8_t hand2[7] = {hole2[0], hole2[1]};
+    uint64_t dead = 0;
+    size_t deadCount = 0;
+    for (uint8_t card : {hole1[0], hole1[1], hole2[0], hole2[1]}) {
+        if (card >= 52) throw std::invalid_argument("Card index must be 0-51");
+        dead |= uint64_t(1) << card;
+        ++deadCount;
+    }
+    for (size_t i = 0; i < boardSize; ++i) {
+        if (board[i] >= 52) throw std::invalid_argument("Card index must be 0-51");
+        hand1[2 + i] = board[i];
+        hand2[2 + i] = board[i];
+        dead |= uint64_t(1) << board[i];
+        ++deadCount;
+    }
+    if (size_t(__builtin_popcountll(dead)) != deadCount) {
+        throw std::invalid_argument("Duplicate cards in equity request");
+    }
+
+    EquityResult result;
+    enumerateRunouts(hand1, hand2, 2 + boardSize, dead, 0, result);
+    return result;
+}
+
+} // namespace poker
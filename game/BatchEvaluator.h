@@ -0,0 +1,47 @@
+#pragma once
+
+#include "HandEvaluation.h"
+#include <cstdint>
+#include <cstddef>
+
+namespace poker {
+
+// Cards of one hand as card indices (Card::getIndex)
+struct HandCards {
+    uint8_t cards[7];
+    uint8_t count;
+};
+
+// Exhaustive all-in result for hand 1 against hand 2
+struct EquityResult {
+    uint32_t wins = 0;
+    uint32_t ties = 0;
+    uint32_t losses = 0;
+
+    // Hand 1 share of the pot, ties split
+    double equity() const;
+};
+
+// Hold'em evaluation over card indices, for callers that evaluate many hands
+// at once (servers, equity sweeps). Scores are HoldemEvaluator packed scores.
+// Every entry point throws std::invalid_argument for a card index of 52 or
+// more or a card count out of range.
+class BatchEvaluator {
+public:
+    // Score of a 5-7 card hand
+    static uint32_t score(const uint8_t* cards, size_t count);
+
+    // Score every hand in a batch; all hands are checked before any is scored
+    static void scoreBatch(const HandCards* hands, size_t count, uint32_t* scores);
+
+    // Compare two hole card pairs on a complete five-card board (nine
+    // distinct cards)
+    static CompareResult compare(const uint8_t* hole1, const uint8_t* hole2,
+                                 const uint8_t* board);
+
+    // Enumerate every runout of a 0-5 card board
+    static EquityResult equity(const uint8_t* hole1, const uint8_t* hole2,
+                               const uint8_t* board, size_t boardSize);
+};
+
+} // namespace poker
@@ -19,6 +19,10 @@ uint8_t Card::getRankValue() const {
     return static_cast<uint8_t>(rank_);
 }
 
+uint8_t Card::getIndex() const {
+    return static_cast<uint8_t>((getRankValue() - 2) * 4 + static_cast<uint8_t>(suit_));
+}
+
 std::string Card::toString() const {
     std::string result;
 
@@ -72,6 +76,13 @@ Card Card::fromString(const std::string& str) {
     return Card(parseRank(str[0]), parseSuit(str[1]));
 }
 
+Card Card::fromIndex(uint8_t index) {
+    if (index >= 52) {
+        throw std::invalid_argument("Card index must be 0-51");
+    }
+    return Card(static_cast<Rank>(index / 4 + 2), static_cast<Suit>(index % 4));
+}
+
 Rank Card::parseRank(char c) {
     switch (c) {
         case '2': return Rank::TWO;
@@ -40,6 +40,9 @@ public:
     // Returns value 2-14 for rank comparisons
     uint8_t getRankValue() const;
 
+    // Returns index 0-51 ordered by rank then suit: (rank - 2) * 4 + suit
+    uint8_t getIndex() const;
+
     // Returns string like "As", "Kh", "2c"
     std::string toString() const;
 
@@ -49,6 +52,7 @@ public:
 
     // Parse from string like "As", "Kh", "2c"
     static Card fromString(const std::string& str);
+    static Card fromIndex(uint8_t index);
     static Rank parseRank(char c);
     static Suit parseSuit(char c);
 
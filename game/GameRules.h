@@ -0,0 +1,55 @@
+#pragma once
+
+#include "HandEvaluation.h"
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace poker {
+
+// How hole cards may be combined with the board to make a five-card hand
+enum class HoleUsage : uint8_t {
+    ANY = 0,          // Best five of hole + board (hold'em, short-deck)
+    EXACTLY_TWO = 1   // Exactly two hole cards and three board cards (Omaha)
+};
+
+// Rules policies for VariantEvaluator. Every member is constexpr so each
+// evaluator instantiation is specialized at compile time.
+//
+//   kMinRank          lowest rank in the deck; the ace-low straight is the ace
+//                     plus the four lowest ranks (A-2-3-4-5, or A-6-7-8-9)
+//   kHoleCards        hole cards dealt to each player; score() rejects others
+//   kHoleUsage        hole card usage constraint
+//   kCategoryStrength strength of each HandRank in this variant, indexed by
+//                     the HandRank value (higher wins)
+
+struct HoldemRules {
+    static constexpr uint8_t kMinRank = 2;
+    static constexpr size_t kHoleCards = 2;
+    static constexpr HoleUsage kHoleUsage = HoleUsage::ANY;
+    static constexpr std::array<uint8_t, 11> kCategoryStrength = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10
+    };
+};
+
+// 6+ hold'em: 36 card deck, flush beats full house
+struct ShortDeckRules {
+    static constexpr uint8_t kMinRank = 6;
+    static constexpr size_t kHoleCards = 2;
+    static constexpr HoleUsage kHoleUsage = HoleUsage::ANY;
+    static constexpr std::array<uint8_t, 11> kCategoryStrength = {
+        0, 1, 2, 3, 4, 5, 7, 6, 8, 9, 10
+    };
+};
+
+// Four card Omaha: hand must use exactly two hole cards
+struct OmahaRules {
+    static constexpr uint8_t kMinRank = 2;
+    static constexpr size_t kHoleCards = 4;
+    static constexpr HoleUsage kHoleUsage = HoleUsage::EXACTLY_TWO;
+    static constexpr std::array<uint8_t, 11> kCategoryStrength = {
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10
+    };
+};
+
+} // namespace poker
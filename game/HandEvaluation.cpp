@@ -25,55 +25,133 @@ bool HandResult::operator==(const HandResult& other) const {
     return !(*this < other) && !(other < *this);
 }
 
-HandResult HandEvaluator::evaluate(const std::vector<Card>& cards) {
-    if (cards.size() < 5) {
-        throw std::invalid_argument("Need at least 5 cards to evaluate");
+namespace {
+
+// Everything the classifier needs, gathered in one pass over the cards
+struct CardCounts {
+    uint8_t ranks[13] = {};   // Cards held of each rank, index = rank value - 2
+    uint16_t suits[4] = {};   // Rank mask of each suit, bit = rank value
+
+    void add(const Card& card) {
+        uint8_t rank = card.getRankValue();
+        ++ranks[rank - 2];
+        suits[static_cast<uint8_t>(card.getSuit())] |= static_cast<uint16_t>(1u << rank);
     }
+};
 
-    HandResult result;
-    std::vector<uint8_t> tiebreakers;
+uint8_t highest(uint32_t mask) {
+    return mask ? static_cast<uint8_t>(31 - __builtin_clz(mask)) : 0;
+}
+
+// The n highest ranks of a mask, as a mask. Comparing two of these as
+// integers orders them the way their descending rank lists compare.
+uint32_t keepHighest(uint32_t mask, int n) {
+    while (__builtin_popcount(mask) > n) mask &= mask - 1;
+    return mask;
+}
+
+void appendHighest(Tiebreakers& out, uint32_t mask, int n) {
+    for (mask = keepHighest(mask, n); mask; mask &= ~(1u << highest(mask))) {
+        out.push_back(highest(mask));
+    }
+}
+
+// High card of the best straight in a rank mask, 0 if none. The ace is
+// copied down to bit 1 so the wheel is found by the same run test.
+uint8_t straightHigh(uint32_t mask) {
+    uint32_t m = mask | ((mask >> 13) & 2u);
+    return highest(m & (m << 1) & (m << 2) & (m << 3) & (m << 4));
+}
 
-    // Check from strongest to weakest
-    if (!(tiebreakers = checkRoyalFlush(cards)).empty()) {
-        result.rank = HandRank::ROYAL_FLUSH;
-        result.tiebreakers = tiebreakers;
-    } else if (!(tiebreakers = checkStraightFlush(cards)).empty()) {
-        result.rank = HandRank::STRAIGHT_FLUSH;
-        result.tiebreakers = tiebreakers;
-    } else if (!(tiebreakers = checkFourOfAKind(cards)).empty()) {
+HandResult classify(const CardCounts& counts) {
+    // Ranks held at least once, twice, three and four times
+    uint32_t seen = 0, pairs = 0, trips = 0, quads = 0;
+    for (uint8_t i = 0; i < 13; ++i) {
+        uint8_t count = counts.ranks[i];
+        uint32_t bit = 1u << (i + 2);
+        seen |= count >= 1 ? bit : 0;
+        pairs |= count >= 2 ? bit : 0;
+        trips |= count >= 3 ? bit : 0;
+        quads |= count >= 4 ? bit : 0;
+    }
+
+    uint8_t straightFlush = 0;
+    uint32_t flush = 0;
+    for (uint16_t suit : counts.suits) {
+        if (__builtin_popcount(suit) < 5) continue;
+        uint8_t high = straightHigh(suit);
+        if (high > straightFlush) straightFlush = high;
+        uint32_t top = keepHighest(suit, 5);
+        if (top > flush) flush = top;
+    }
+
+    HandResult result;
+    if (straightFlush) {
+        result.rank = straightFlush == 14 ? HandRank::ROYAL_FLUSH : HandRank::STRAIGHT_FLUSH;
+        result.tiebreakers.push_back(straightFlush);
+    } else if (quads) {
+        uint8_t quad = highest(quads);
         result.rank = HandRank::FOUR_OF_A_KIND;
-        result.tiebreakers = tiebreakers;
-    } else if (!(tiebreakers = checkFullHouse(cards)).empty()) {
+        result.tiebreakers = {quad, highest(seen & ~(1u << quad))};
+    } else if (trips && (pairs & ~(1u << highest(trips)))) {
+        uint8_t trip = highest(trips);
         result.rank = HandRank::FULL_HOUSE;
-        result.tiebreakers = tiebreakers;
-    } else if (!(tiebreakers = checkFlush(cards)).empty()) {
+        result.tiebreakers = {trip, highest(pairs & ~(1u << trip))};
+    } else if (flush) {
         result.rank = HandRank::FLUSH;
-        result.tiebreakers = tiebreakers;
-    } else if (!(tiebreakers = checkStraight(cards)).empty()) {
+        appendHighest(result.tiebreakers, flush, 5);
+    } else if (uint8_t high = straightHigh(seen)) {
         result.rank = HandRank::STRAIGHT;
-        result.tiebreakers = tiebreakers;
-    } else if (!(tiebreakers = checkThreeOfAKind(cards)).empty()) {
+        result.tiebreakers.push_back(high);
+    } else if (trips) {
+        uint8_t trip = highest(trips);
         result.rank = HandRank::THREE_OF_A_KIND;
-        result.tiebreakers = tiebreakers;
-    } else if (!(tiebreakers = checkTwoPair(cards)).empty()) {
+        result.tiebreakers.push_back(trip);
+        appendHighest(result.tiebreakers, seen & ~(1u << trip), 2);
+    } else if (__builtin_popcount(pairs) >= 2) {
+        uint32_t top = keepHighest(pairs, 2);
         result.rank = HandRank::TWO_PAIR;
-        result.tiebreakers = tiebreakers;
-    } else if (!(tiebreakers = checkPair(cards)).empty()) {
+        appendHighest(result.tiebreakers, top, 2);
+        result.tiebreakers.push_back(highest(seen & ~top));
+    } else if (pairs) {
         result.rank = HandRank::PAIR;
-        result.tiebreakers = tiebreakers;
+        result.tiebreakers.push_back(highest(pairs));
+        appendHighest(result.tiebreakers, seen & ~pairs, 3);
     } else {
         result.rank = HandRank::HIGH_CARD;
-        result.tiebreakers = getHighCard(cards);
+        appendHighest(result.tiebreakers, seen, 5);
     }
-
     return result;
 }
 
+} // namespace
+
+HandResult HandEvaluator::evaluate(const std::vector<Card>& cards) {
+    if (cards.size() < 5) {
+        throw std::invalid_argument("Need at least 5 cards to evaluate");
+    }
+
+    CardCounts counts;
+    for (const auto& card : cards) {
+        counts.add(card);
+    }
+    return classify(counts);
+}
+
 HandResult HandEvaluator::evaluate(const std::vector<Card>& holeCards,
                                     const std::vector<Card>& community) {
-    std::vector<Card> allCards = holeCards;
-    allCards.insert(allCards.end(), community.begin(), community.end());
-    return evaluate(allCards);
+    if (holeCards.size() + community.size() < 5) {
+        throw std::invalid_argument("Need at least 5 cards to evaluate");
+    }
+
+    CardCounts counts;
+    for (const auto& card : holeCards) {
+        counts.add(card);
+    }
+    for (const auto& card : community) {
+        counts.add(card);
+    }
+    return classify(counts);
 }
 
 CompareResult HandEvaluator::compare(const std::vector<Card>& holeCards1,
@@ -103,220 +181,4 @@ std::string HandEvaluator::handRankToString(HandRank rank) {
     }
 }
 
-std::map<uint8_t, int> HandEvaluator::getRankFrequency(const std::vector<Card>& cards) {
-    std::map<uint8_t, int> freq;
-    for (const auto& card : cards) {
-        freq[card.getRankValue()]++;
-    }
-    return freq;
-}
-
-std::map<Suit, std::vector<Card>> HandEvaluator::getSuitGroups(const std::vector<Card>& cards) {
-    std::map<Suit, std::vector<Card>> groups;
-    for (const auto& card : cards) {
-        groups[card.getSuit()].push_back(card);
-    }
-    return groups;
-}
-
-std::vector<Card> HandEvaluator::sortByRankDescending(std::vector<Card> cards) {
-    std::sort(cards.begin(), cards.end(), [](const Card& a, const Card& b) {
-        return a.getRankValue() > b.getRankValue();
-    });
-    return cards;
-}
-
-std::vector<uint8_t> HandEvaluator::getKickers(const std::vector<Card>& cards,
-                                                const std::vector<uint8_t>& exclude,
-                                                size_t count) {
-    std::vector<uint8_t> kickers;
-    auto sorted = sortByRankDescending(cards);
-
-    for (const auto& card : sorted) {
-        uint8_t rank = card.getRankValue();
-        bool excluded = std::find(exclude.begin(), exclude.end(), rank) != exclude.end();
-        if (!excluded) {
-            kickers.push_back(rank);
-            if (kickers.size() >= count) break;
-        }
-    }
-    return kickers;
-}
-
-std::vector<uint8_t> HandEvaluator::checkRoyalFlush(const std::vector<Card>& cards) {
-    auto suitGroups = getSuitGroups(cards);
-
-    for (const auto& [suit, suitCards] : suitGroups) {
-        if (suitCards.size() >= 5) {
-            std::vector<bool> hasRank(15, false);
-            for (const auto& card : suitCards) {
-                hasRank[card.getRankValue()] = true;
-            }
-            // Check for A, K, Q, J, T of same suit
-            if (hasRank[14] && hasRank[13] && hasRank[12] && hasRank[11] && hasRank[10]) {
-                return {14}; // Ace high
-            }
-        }
-    }
-    return {};
-}
-
-std::vector<uint8_t> HandEvaluator::checkStraightFlush(const std::vector<Card>& cards) {
-    auto suitGroups = getSuitGroups(cards);
-
-    for (const auto& [suit, suitCards] : suitGroups) {
-        if (suitCards.size() >= 5) {
-            auto straightResult = checkStraight(suitCards);
-            if (!straightResult.empty()) {
-                return straightResult;
-            }
-        }
-    }
-    return {};
-}
-
-std::vector<uint8_t> HandEvaluator::checkFourOfAKind(const std::vector<Card>& cards) {
-    auto freq = getRankFrequency(cards);
-
-    for (const auto& [rank, count] : freq) {
-        if (count == 4) {
-            auto kickers = getKickers(cards, {rank}, 1);
-            return {rank, kickers.empty() ? uint8_t(0) : kickers[0]};
-        }
-    }
-    return {};
-}
-
-std::vector<uint8_t> HandEvaluator::checkFullHouse(const std::vector<Card>& cards) {
-    auto freq = getRankFrequency(cards);
-
-    uint8_t threeRank = 0;
-    uint8_t pairRank = 0;
-
-    // Find the highest three of a kind
-    for (auto it = freq.rbegin(); it != freq.rend(); ++it) {
-        if (it->second >= 3 && threeRank == 0) {
-            threeRank = it->first;
-        }
-    }
-
-    if (threeRank == 0) return {};
-
-    // Find the highest pair (can also be three of a kind)
-    for (auto it = freq.rbegin(); it != freq.rend(); ++it) {
-        if (it->second >= 2 && it->first != threeRank && pairRank == 0) {
-            pairRank = it->first;
-        }
-    }
-
-    if (pairRank == 0) return {};
-
-    return {threeRank, pairRank};
-}
-
-std::vector<uint8_t> HandEvaluator::checkFlush(const std::vector<Card>& cards) {
-    auto suitGroups = getSuitGroups(cards);
-
-    for (const auto& [suit, suitCards] : suitGroups) {
-        if (suitCards.size() >= 5) {
-            auto sorted = sortByRankDescending(suitCards);
-            std::vector<uint8_t> result;
-            for (size_t i = 0; i < 5 && i < sorted.size(); ++i) {
-                result.push_back(sorted[i].getRankValue());
-            }
-            return result;
-        }
-    }
-    return {};
-}
-
-std::vector<uint8_t> HandEvaluator::checkStraight(const std::vector<Card>& cards) {
-    std::vector<bool> hasRank(15, false);
-    for (const auto& card : cards) {
-        hasRank[card.getRankValue()] = true;
-    }
-
-    // Check for straights from high to low
-    // Ace can be high (14) or low (1)
-    for (int high = 14; high >= 5; --high) {
-        bool isStraight = true;
-        for (int i = 0; i < 5; ++i) {
-            int rank = high - i;
-            // Handle ace-low straight (A-2-3-4-5)
-            if (rank == 1) rank = 14;
-            if (!hasRank[rank]) {
-                isStraight = false;
-                break;
-            }
-        }
-        if (isStraight) {
-            return {static_cast<uint8_t>(high)};
-        }
-    }
-
-    // Check for ace-low straight (wheel): A-2-3-4-5
-    if (hasRank[14] && hasRank[2] && hasRank[3] && hasRank[4] && hasRank[5]) {
-        return {5}; // 5-high straight
-    }
-
-    return {};
-}
-
-std::vector<uint8_t> HandEvaluator::checkThreeOfAKind(const std::vector<Card>& cards) {
-    auto freq = getRankFrequency(cards);
-
-    for (auto it = freq.rbegin(); it != freq.rend(); ++it) {
-        if (it->second == 3) {
-            auto kickers = getKickers(cards, {it->first}, 2);
-            std::vector<uint8_t> result = {it->first};
-            result.insert(result.end(), kickers.begin(), kickers.end());
-            return result;
-        }
-    }
-    return {};
-}
-
-std::vector<uint8_t> HandEvaluator::checkTwoPair(const std::vector<Card>& cards) {
-    auto freq = getRankFrequency(cards);
-
-    std::vector<uint8_t> pairs;
-    for (auto it = freq.rbegin(); it != freq.rend(); ++it) {
-        if (it->second >= 2) {
-            pairs.push_back(it->first);
-        }
-    }
-
-    if (pairs.size() >= 2) {
-        std::sort(pairs.rbegin(), pairs.rend());
-        uint8_t highPair = pairs[0];
-        uint8_t lowPair = pairs[1];
-        auto kickers = getKickers(cards, {highPair, lowPair}, 1);
-        return {highPair, lowPair, kickers.empty() ? uint8_t(0) : kickers[0]};
-    }
-    return {};
-}
-
-std::vector<uint8_t> HandEvaluator::checkPair(const std::vector<Card>& cards) {
-    auto freq = getRankFrequency(cards);
-
-    for (auto it = freq.rbegin(); it != freq.rend(); ++it) {
-        if (it->second == 2) {
-            auto kickers = getKickers(cards, {it->first}, 3);
-            std::vector<uint8_t> result = {it->first};
-            result.insert(result.end(), kickers.begin(), kickers.end());
-            return result;
-        }
-    }
-    return {};
-}
-
-std::vector<uint8_t> HandEvaluator::getHighCard(const std::vector<Card>& cards) {
-    auto sorted = sortByRankDescending(cards);
-    std::vector<uint8_t> result;
-    for (size_t i = 0; i < 5 && i < sorted.size(); ++i) {
-        result.push_back(sorted[i].getRankValue());
-    }
-    return result;
-}
-
 } // namespace poker
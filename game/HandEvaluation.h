@@ -3,7 +3,8 @@
 #include "Card.h"
 #include <vector>
 #include <array>
-#include <map>
+#include <cstddef>
+#include <initializer_list>
 
 namespace poker {
 
@@ -20,9 +21,44 @@ enum class HandRank : uint8_t {
     ROYAL_FLUSH = 10
 };
 
+// Up to five tiebreaker ranks stored inline, so results never allocate
+class Tiebreakers {
+public:
+    static constexpr size_t kCapacity = 5;
+
+    Tiebreakers() = default;
+    Tiebreakers(std::initializer_list<uint8_t> values) {
+        for (uint8_t value : values) push_back(value);
+    }
+
+    void push_back(uint8_t value) {
+        if (size_ < kCapacity) values_[size_++] = value;
+    }
+    void clear() { size_ = 0; }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    uint8_t operator[](size_t i) const { return values_[i]; }
+    const uint8_t* begin() const { return values_.data(); }
+    const uint8_t* end() const { return values_.data() + size_; }
+
+    bool operator==(const Tiebreakers& other) const {
+        if (size_ != other.size_) return false;
+        for (size_t i = 0; i < size_; ++i) {
+            if (values_[i] != other.values_[i]) return false;
+        }
+        return true;
+    }
+    bool operator!=(const Tiebreakers& other) const { return !(*this == other); }
+
+private:
+    std::array<uint8_t, kCapacity> values_{};
+    uint8_t size_ = 0;
+};
+
 struct HandResult {
     HandRank rank;
-    std::vector<uint8_t> tiebreakers;  // Values for comparing same-ranked hands
+    Tiebreakers tiebreakers;  // Values for comparing same-ranked hands
 
     bool operator<(const HandResult& other) const;
     bool operator>(const HandResult& other) const;
@@ -36,6 +72,9 @@ enum class CompareResult {
     HAND2_WINS = -1
 };
 
+// Reference evaluator. Each call makes one pass over the cards into a rank
+// count array and four suit masks on the stack, then classifies with bit
+// tricks: no lookup tables and no heap allocation.
 class HandEvaluator {
 public:
     // Evaluate a 5-7 card hand and return the best 5-card ranking
@@ -52,27 +91,6 @@ public:
 
     // Get string representation of hand rank
     static std::string handRankToString(HandRank rank);
-
-private:
-    // Check for specific hands - return tiebreakers if found, empty if not
-    static std::vector<uint8_t> checkRoyalFlush(const std::vector<Card>& cards);
-    static std::vector<uint8_t> checkStraightFlush(const std::vector<Card>& cards);
-    static std::vector<uint8_t> checkFourOfAKind(const std::vector<Card>& cards);
-    static std::vector<uint8_t> checkFullHouse(const std::vector<Card>& cards);
-    static std::vector<uint8_t> checkFlush(const std::vector<Card>& cards);
-    static std::vector<uint8_t> checkStraight(const std::vector<Card>& cards);
-    static std::vector<uint8_t> checkThreeOfAKind(const std::vector<Card>& cards);
-    static std::vector<uint8_t> checkTwoPair(const std::vector<Card>& cards);
-    static std::vector<uint8_t> checkPair(const std::vector<Card>& cards);
-    static std::vector<uint8_t> getHighCard(const std::vector<Card>& cards);
-
-    // Helper functions
-    static std::map<uint8_t, int> getRankFrequency(const std::vector<Card>& cards);
-    static std::map<Suit, std::vector<Card>> getSuitGroups(const std::vector<Card>& cards);
-    static std::vector<uint8_t> getKickers(const std::vector<Card>& cards,
-                                           const std::vector<uint8_t>& exclude,
-                                           size_t count);
-    static std::vector<Card> sortByRankDescending(std::vector<Card> cards);
 };
 
 } // namespace poker
@@ -0,0 +1,321 @@
+#include "HandStrengthDistribution.h"
+#include "VariantEvaluation.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace poker {
+
+namespace {
+
+// Run f(0..count-1) on up to `threads` workers pulling tasks from a counter
+template <typename F>
+void parallelFor(size_t count, unsigned threads, F f) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<size_t>(threads, count));
+
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t task; (task = next.fetch_add(1)) < count;) {
+            f(task);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; ++i) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+void putU16(std::ostream& out, uint16_t value) {
+    char bytes[2] = {static_cast<char>(value & 0xFF), static_cast<char>(value >> 8)};
+    out.write(bytes, 2);
+}
+
+} // namespace
+
+HandStrengthDistribution::HandStrengthDistribution(const std::vector<Card>& board,
+                                                   const Range& hands,
+                                                   const Range& opponents, size_t bins)
+    : opponents_(opponents), bins_(bins) {
+    if (board.size() != 3 && board.size() != 4) {
+        throw std::invalid_argument("Distribution board must have 3 or 4 cards");
+    }
+    if (bins == 0 || bins >= NO_CARD) {
+        throw std::invalid_argument("Distribution bins must be 1-254");
+    }
+
+    uint64_t dead = Range::cardMask(board);
+    if (size_t(__builtin_popcountll(dead)) != board.size()) {
+        throw std::invalid_argument("Duplicate board cards");
+    }
+    for (const auto& card : board) {
+        board_.push_back(card.getIndex());
+    }
+    opponents_.removeBlocked(dead);
+
+    slotOf_.assign(Range::NUM_COMBOS, -1);
+    for (size_t combo = 0; combo < Range::NUM_COMBOS; ++combo) {
+        auto [hi, lo] = Range::comboCards(combo);
+        if (dead & ((uint64_t(1) << hi) | (uint64_t(1) << lo))) continue;
+
+        if (hands[combo] > 0.0f) {
+            slotOf_[combo] = static_cast<int16_t>(combos_.size());
+            combos_.push_back(static_cast<uint16_t>(combo));
+        }
+        if (hands[combo] > 0.0f || opponents_[combo] > 0.0f) {
+            scored_.push_back(static_cast<uint16_t>(combo));
+        }
+    }
+}
+
+void HandStrengthDistribution::riverBins(const uint8_t* board, uint8_t* slotBins) const {
+    Scratch scratch;
+    riverBins(board, slotBins, scratch);
+}
+
+void HandStrengthDistribution::riverBins(const uint8_t* board, uint8_t* slotBins,
+                                         Scratch& scratch) const {
+    scratch.shares.resize(combos_.size());
+    riverShares(board, scratch.shares.data(), scratch);
+    for (size_t slot = 0; slot < combos_.size(); ++slot) {
+        const ShowdownShare& share = scratch.shares[slot];
+        if (share.seen <= 0.0f) {
+            slotBins[slot] = NO_CARD;
+        } else {
+            size_t bin = static_cast<size_t>(std::max(share.equity(), 0.0f) * bins_);
+            slotBins[slot] = static_cast<uint8_t>(std::min(bin, bins_ - 1));
+        }
+    }
+}
+
+void HandStrengthDistribution::riverStrengths(const uint8_t* board, float* slotStrengths) const {
+    Scratch scratch;
+    scratch.shares.resize(combos_.size());
+    riverShares(board, scratch.shares.data(), scratch);
+    for (size_t slot = 0; slot < combos_.size(); ++slot) {
+        const ShowdownShare& share = scratch.shares[slot];
+        slotStrengths[slot] = share.seen > 0.0f ? std::max(share.equity(), 0.0f) : -1.0f;
+    }
+}
+
+void HandStrengthDistribution::riverShares(const uint8_t* board, ShowdownShare* slotShares) const {
+    Scratch scratch;
+    riverShares(board, slotShares, scratch);
+}
+
+void HandStrengthDistribution::riverShares(const uint8_t* board, ShowdownShare* slotShares,
+                                           Scratch& scratch) const {
+    std::fill(slotShares, slotShares + combos_.size(), ShowdownShare());
+
+    uint64_t dead = 0;
+    uint8_t cards[7];
+    for (int i = 0; i < 5; ++i) {
+        dead |= uint64_t(1) << board[i];
+        cards[2 + i] = board[i];
+    }
+
+    // Weight sums run in double: blocked weight is subtracted back out below
+    // and must cancel to (near) zero when a hand faces nothing
+    auto& entries = scratch.entries;
+    entries.clear();
+    std::array<double, 52> cardTotal{};
+    double total = 0.0;
+    for (uint16_t combo : scored_) {
+        auto [hi, lo] = Range::comboCards(combo);
+        if (dead & ((uint64_t(1) << hi) | (uint64_t(1) << lo))) continue;
+
+        cards[0] = hi;
+        cards[1] = lo;
+        entries.push_back(uint64_t(HoldemEvaluator::scoreIndices(cards, 7)) << 16 | combo);
+
+        double weight = opponents_[combo];
+        cardTotal[hi] += weight;
+        cardTotal[lo] += weight;
+        total += weight;
+    }
+    std::sort(entries.begin(), entries.end());
+    const double empty = total * 1e-9;
+
+    // Sweep equal-score groups from weakest up. Opponent weight sharing a card
+    // with (hi, lo) is card[hi] + card[lo] - w(hi, lo), by inclusion-exclusion.
+    std::array<double, 52> belowCard{};
+    std::array<double, 52> groupCard{};
+    double below = 0.0;
+    for (size_t start = 0, end; start < entries.size(); start = end) {
+        uint64_t score = entries[start] >> 16;
+        double group = 0.0;
+        for (end = start; end < entries.size() && (entries[end] >> 16) == score; ++end) {
+            auto [hi, lo] = Range::comboCards(entries[end] & 0xFFFF);
+            double weight = opponents_[entries[end] & 0xFFFF];
+            groupCard[hi] += weight;
+            groupCard[lo] += weight;
+            group += weight;
+        }
+
+        for (size_t i = start; i < end; ++i) {
+            uint16_t combo = static_cast<uint16_t>(entries[i] & 0xFFFF);
+            int16_t slot = slotOf_[combo];
+            if (slot < 0) continue;
+
+            auto [hi, lo] = Range::comboCards(combo);
+            double own = opponents_[combo];
+            double wins = below - belowCard[hi] - belowCard[lo];
+            double ties = group - groupCard[hi] - groupCard[lo] + own;
+            double seen = total - cardTotal[hi] - cardTotal[lo] + own;
+
+            if (seen <= empty) continue;
+            slotShares[slot] = {static_cast<float>(std::max(wins, 0.0)),
+                                static_cast<float>(std::max(ties, 0.0)),
+                                static_cast<float>(seen)};
+        }
+
+        for (size_t i = start; i < end; ++i) {
+            auto [hi, lo] = Range::comboCards(entries[i] & 0xFFFF);
+            belowCard[hi] += groupCard[hi];
+            belowCard[lo] += groupCard[lo];
+            groupCard[hi] = 0.0;
+            groupCard[lo] = 0.0;
+        }
+        below += group;
+    }
+}
+
+void HandStrengthDistribution::compute(
+    const std::function<void(const DistributionRecord&)>& sink, unsigned threads) const {
+    size_t slots = combos_.size();
+    uint64_t dead = 0;
+    for (uint8_t card : board_) {
+        dead |= uint64_t(1) << card;
+    }
+    std::vector<uint8_t> live;
+    for (uint8_t card = 0; card < 52; ++card) {
+        if (!(dead & (uint64_t(1) << card))) live.push_back(card);
+    }
+
+    // Each river board once: turn boards need every live river, flop boards
+    // every unordered (turn, river) pair. Task t owns the pairs (live[t], r)
+    // with r after it, so turn t is complete once tasks 0..t are.
+    std::vector<std::array<uint8_t, 2>> runouts;
+    std::vector<size_t> taskStart;
+    std::vector<int> pairIndex(52 * 52, -1);
+    for (size_t t = 0; t < live.size(); ++t) {
+        taskStart.push_back(runouts.size());
+        if (board_.size() == 4) {
+            runouts.push_back({live[t], NO_CARD});
+            continue;
+        }
+        for (size_t r = t + 1; r < live.size(); ++r) {
+            pairIndex[live[t] * 52 + live[r]] = static_cast<int>(runouts.size());
+            pairIndex[live[r] * 52 + live[t]] = static_cast<int>(runouts.size());
+            runouts.push_back({live[t], live[r]});
+        }
+    }
+    taskStart.push_back(runouts.size());
+
+    // Workers publish how many leading tasks are finished; the calling thread
+    // rolls up and emits each turn as soon as its prefix is done
+    std::vector<uint8_t> results(runouts.size() * slots);
+    std::vector<char> taskDone(live.size(), 0);
+    size_t donePrefix = 0;
+    std::mutex doneMutex;
+    std::condition_variable doneChanged;
+    std::atomic<bool> abandoned(false);
+
+    std::thread evaluator([&]() {
+        parallelFor(live.size(), threads, [&](size_t task) {
+            if (!abandoned) {
+                Scratch scratch;
+                uint8_t river[5];
+                std::copy(board_.begin(), board_.end(), river);
+                for (size_t i = taskStart[task]; i < taskStart[task + 1]; ++i) {
+                    river[board_.size()] = runouts[i][0];
+                    if (board_.size() == 3) river[4] = runouts[i][1];
+                    riverBins(river, results.data() + i * slots, scratch);
+                }
+            }
+            std::lock_guard<std::mutex> lock(doneMutex);
+            taskDone[task] = 1;
+            while (donePrefix < live.size() && taskDone[donePrefix]) ++donePrefix;
+            doneChanged.notify_one();
+        });
+    });
+    auto waitFor = [&](size_t tasks) {
+        std::unique_lock<std::mutex> lock(doneMutex);
+        doneChanged.wait(lock, [&]() { return donePrefix >= tasks; });
+    };
+
+    auto addRiver = [&](size_t runout, std::vector<uint16_t>& counts) {
+        const uint8_t* slotBins = results.data() + runout * slots;
+        for (size_t slot = 0; slot < slots; ++slot) {
+            if (slotBins[slot] != NO_CARD) ++counts[slot * bins_ + slotBins[slot]];
+        }
+    };
+
+    try {
+        if (board_.size() == 4) {
+            waitFor(live.size());
+            std::vector<uint16_t> counts(slots * bins_);
+            for (size_t i = 0; i < runouts.size(); ++i) {
+                addRiver(i, counts);
+            }
+            sink({4, NO_CARD, counts.data()});
+        } else {
+            // Roll rivers up into each turn histogram, then turns into the flop
+            std::vector<uint16_t> flop(slots * bins_);
+            std::vector<uint16_t> turn(slots * bins_);
+            for (size_t t = 0; t < live.size(); ++t) {
+                waitFor(t + 1);
+                uint8_t turnCard = live[t];
+                std::fill(turn.begin(), turn.end(), 0);
+                for (uint8_t riverCard : live) {
+                    if (riverCard != turnCard) addRiver(pairIndex[turnCard * 52 + riverCard], turn);
+                }
+                sink({4, turnCard, turn.data()});
+
+                for (size_t i = 0; i < turn.size(); ++i) {
+                    flop[i] += turn[i];
+                }
+            }
+            sink({3, NO_CARD, flop.data()});
+        }
+    } catch (...) {
+        abandoned = true;
+        evaluator.join();
+        throw;
+    }
+    evaluator.join();
+}
+
+void HandStrengthDistribution::write(std::ostream& out, unsigned threads) const {
+    out.write("HSD1", 4);
+    out.put(static_cast<char>(board_.size()));
+    for (uint8_t card : board_) {
+        out.put(static_cast<char>(card));
+    }
+    putU16(out, static_cast<uint16_t>(bins_));
+    putU16(out, static_cast<uint16_t>(combos_.size()));
+    for (uint16_t combo : combos_) {
+        putU16(out, combo);
+    }
+
+    size_t values = combos_.size() * bins_;
+    compute([&](const DistributionRecord& record) {
+        out.put(static_cast<char>(record.boardSize));
+        out.put(static_cast<char>(record.card));
+        for (size_t i = 0; i < values; ++i) {
+            putU16(out, record.counts[i]);
+        }
+        out.flush();
+    }, threads);
+}
+
+} // namespace poker
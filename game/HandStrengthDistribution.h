@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Card.h"
+#include "Range.h"
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <vector>
+
+namespace poker {
+
+// Histogram of river strengths for every hand slot, conditioned on one board.
+// counts[slot * bins + bin] is the number of rivers on which the hand in
+// that slot landed in bin.
+struct DistributionRecord {
+    uint8_t boardSize;   // 4 = turn histogram, 3 = flop histogram
+    uint8_t card;        // Turn card of a turn histogram; NO_CARD for the root
+    const uint16_t* counts;
+};
+
+// Opponent weight a hand beats, ties and can face on one river board. Sum
+// these over runouts before dividing to get equity against the range: each
+// runout's ratio alone weighs runouts equally, whatever weight they block.
+struct ShowdownShare {
+    float wins = 0.0f;
+    float ties = 0.0f;
+    float seen = 0.0f;
+
+    float equity() const { return seen > 0.0f ? (wins + 0.5f * ties) / seen : -1.0f; }
+    ShowdownShare& operator+=(const ShowdownShare& other) {
+        wins += other.wins;
+        ties += other.ties;
+        seen += other.seen;
+        return *this;
+    }
+};
+
+// River strength distributions for every hand in a range, from the flop or
+// the turn.
+//
+// The river strength of a hand is the share of the opponent range it beats
+// on a complete board, ties counting half, with card removal applied. It is
+// bucketed into `bins` equal-width bins.
+//
+// Each river board is evaluated exactly once (in parallel, one turn card per
+// task) and the per-river bins are then rolled up into turn histograms and
+// the flop histogram, rather than re-enumerating runouts for each street.
+// The flop histogram is the sum of the turn histograms, so it counts
+// (turn, river) sequences: each river board appears once per turn order.
+class HandStrengthDistribution {
+public:
+    static constexpr uint8_t NO_CARD = 0xFF;
+
+    // board: 3 or 4 cards. hands: combos to report (weight > 0).
+    // opponents: range strength is measured against (weights used as-is).
+    HandStrengthDistribution(const std::vector<Card>& board, const Range& hands,
+                             const Range& opponents, size_t bins = 50);
+
+    // Combo index of each hand slot, in record order
+    const std::vector<uint16_t>& combos() const { return combos_; }
+    size_t bins() const { return bins_; }
+
+    // Compute all histograms. For a flop board, sink receives each turn
+    // histogram (in live card order) as soon as every river board it needs
+    // is evaluated, then the flop histogram; for a turn board it receives
+    // only the turn histogram. The sink runs on the calling thread while
+    // workers continue. threads = 0 uses every core.
+    void compute(const std::function<void(const DistributionRecord&)>& sink,
+                 unsigned threads = 0) const;
+
+    // Stream the binary format (little-endian):
+    //   header: "HSD1" | u8 boardSize | board cards | u16 bins | u16 slots
+    //           | slots x u16 combo index
+    //   record: u8 boardSize | u8 card | slots x bins x u16 counts
+    void write(std::ostream& out, unsigned threads = 0) const;
+
+    // Buffers reused across river evaluations. Each thread needs its own;
+    // the overloads without one allocate a fresh one per call.
+    struct Scratch {
+        std::vector<uint64_t> entries;        // Hand score << 16 | combo
+        std::vector<ShowdownShare> shares;
+    };
+
+    // Strength bin of every hand slot on a complete five-card board given as
+    // card indices; NO_CARD for slots blocked by the board or left facing no
+    // opponent weight
+    void riverBins(const uint8_t* board, uint8_t* slotBins) const;
+    void riverBins(const uint8_t* board, uint8_t* slotBins, Scratch& scratch) const;
+
+    // Unbucketed river strength of every hand slot; -1 where riverBins
+    // reports NO_CARD
+    void riverStrengths(const uint8_t* board, float* slotStrengths) const;
+
+    // Weighted showdown totals behind riverStrengths; all zero where
+    // riverBins reports NO_CARD
+    void riverShares(const uint8_t* board, ShowdownShare* slotShares) const;
+    void riverShares(const uint8_t* board, ShowdownShare* slotShares, Scratch& scratch) const;
+
+private:
+    std::vector<uint8_t> board_;
+    std::vector<uint16_t> combos_;     // Hand slots
+    std::vector<uint16_t> scored_;     // Combos in either range, off the board
+    std::vector<int16_t> slotOf_;      // Hand slot of each combo, -1 if none
+    Range opponents_;
+    size_t bins_;
+};
+
+} // namespace poker
@@ -0,0 +1,234 @@
+#include "OutsAnalyzer.h"
+#include "HandStrengthDistribution.h"
+#include "VariantEvaluation.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace poker {
+
+namespace {
+
+// Ranks held at least once, twice, three and four times (bit = rank value)
+struct RankMasks {
+    uint16_t atLeast[4] = {0, 0, 0, 0};
+
+    void add(uint8_t rank) {
+        uint16_t bit = static_cast<uint16_t>(1u << rank);
+        atLeast[3] |= atLeast[2] & bit;
+        atLeast[2] |= atLeast[1] & bit;
+        atLeast[1] |= atLeast[0] & bit;
+        atLeast[0] |= bit;
+    }
+};
+
+// Best category made by ranks alone
+HandRank rankCategory(const RankMasks& masks) {
+    if (masks.atLeast[3]) return HandRank::FOUR_OF_A_KIND;
+    int pairs = __builtin_popcount(masks.atLeast[1]);
+    if (masks.atLeast[2] && pairs >= 2) return HandRank::FULL_HOUSE;
+    if (HoldemEvaluator::straightHigh(masks.atLeast[0])) return HandRank::STRAIGHT;
+    if (masks.atLeast[2]) return HandRank::THREE_OF_A_KIND;
+    if (pairs >= 2) return HandRank::TWO_PAIR;
+    if (pairs == 1) return HandRank::PAIR;
+    return HandRank::HIGH_CARD;
+}
+
+// Category of a suit holding five or more cards
+HandRank flushCategory(uint16_t suitMask) {
+    uint8_t high = HoldemEvaluator::straightHigh(suitMask);
+    if (high == 14) return HandRank::ROYAL_FLUSH;
+    if (high) return HandRank::STRAIGHT_FLUSH;
+    return HandRank::FLUSH;
+}
+
+HandRank better(HandRank a, HandRank b) {
+    return a > b ? a : b;
+}
+
+struct Holding {
+    RankMasks ranks;
+    uint16_t suits[4] = {0, 0, 0, 0};
+
+    void add(uint8_t card) {
+        uint8_t rank = static_cast<uint8_t>(card / 4 + 2);
+        ranks.add(rank);
+        suits[card % 4] |= static_cast<uint16_t>(1u << rank);
+    }
+
+    HandRank category() const {
+        HandRank result = rankCategory(ranks);
+        for (uint16_t suit : suits) {
+            if (__builtin_popcount(suit) >= 5) result = better(result, flushCategory(suit));
+        }
+        return result;
+    }
+};
+
+void validate(const std::vector<Card>& holeCards, const std::vector<Card>& board) {
+    if (holeCards.size() != 2 || (board.size() != 3 && board.size() != 4)) {
+        throw std::invalid_argument("Outs need 2 hole cards and a 3 or 4 card board");
+    }
+    std::vector<Card> all = holeCards;
+    all.insert(all.end(), board.begin(), board.end());
+    if (size_t(__builtin_popcountll(Range::cardMask(all))) != all.size()) {
+        throw std::invalid_argument("Duplicate cards in outs request");
+    }
+}
+
+} // namespace
+
+uint64_t OutsResult::allOuts() const {
+    uint64_t all = 0;
+    for (uint64_t mask : byCategory) {
+        all |= mask;
+    }
+    return all;
+}
+
+size_t OutsResult::count(HandRank rank) const {
+    return static_cast<size_t>(__builtin_popcountll(outs(rank)));
+}
+
+size_t OutsResult::total() const {
+    return static_cast<size_t>(__builtin_popcountll(allOuts()));
+}
+
+OutsResult OutsAnalyzer::outs(const std::vector<Card>& holeCards,
+                              const std::vector<Card>& board) {
+    validate(holeCards, board);
+
+    uint8_t cards[7];
+    size_t count = 0;
+    Holding hero;
+    Holding boardOnly;
+    uint16_t holeRanks = 0;
+    for (const auto& card : holeCards) {
+        cards[count++] = card.getIndex();
+        hero.add(card.getIndex());
+        holeRanks |= static_cast<uint16_t>(1u << (card.getIndex() / 4 + 2));
+    }
+    for (const auto& card : board) {
+        cards[count++] = card.getIndex();
+        hero.add(card.getIndex());
+        boardOnly.add(card.getIndex());
+    }
+
+    OutsResult result;
+    result.current = hero.category();
+    result.live = ((uint64_t(1) << 52) - 1) & ~Range::cardMask(holeCards) & ~Range::cardMask(board);
+    result.byCategory.fill(0);
+
+    // Rank improvements depend only on the rank of the next card
+    HandRank heroByRank[15];
+    HandRank boardByRank[15];
+    for (uint8_t rank = 2; rank <= 14; ++rank) {
+        RankMasks withHero = hero.ranks;
+        withHero.add(rank);
+        heroByRank[rank] = rankCategory(withHero);
+
+        RankMasks withBoard = boardOnly.ranks;
+        withBoard.add(rank);
+        boardByRank[rank] = rankCategory(withBoard);
+    }
+
+    for (uint64_t remaining = result.live; remaining; remaining &= remaining - 1) {
+        uint8_t card = static_cast<uint8_t>(__builtin_ctzll(remaining));
+        uint8_t rank = static_cast<uint8_t>(card / 4 + 2);
+        uint16_t bit = static_cast<uint16_t>(1u << rank);
+        uint16_t heroSuit = hero.suits[card % 4] | bit;
+        uint16_t boardSuit = boardOnly.suits[card % 4] | bit;
+
+        HandRank next = heroByRank[rank];
+        if (__builtin_popcount(heroSuit) >= 5) {
+            if (next >= HandRank::STRAIGHT) {
+                // Flush and straight-or-better together: let the evaluator decide
+                cards[count] = card;
+                next = HoldemEvaluator::toHandResult(
+                    HoldemEvaluator::scoreIndices(cards, count + 1)).rank;
+            } else {
+                next = HandRank::FLUSH;
+            }
+        }
+
+        HandRank boardNext = boardByRank[rank];
+        if (__builtin_popcount(boardSuit) >= 5) {
+            boardNext = better(boardNext, flushCategory(boardSuit));
+        }
+
+        // Pairs must pair a hole card: a card that pairs the board gives every
+        // hand that pair. Straights, flushes and full houses beating the board
+        // category already need a hole card.
+        if (next <= HandRank::TWO_PAIR && !(holeRanks & bit)) continue;
+
+        if (next > result.current && next > boardNext) {
+            result.byCategory[static_cast<uint8_t>(next)] |= uint64_t(1) << card;
+        }
+    }
+    return result;
+}
+
+NextCardEquity OutsAnalyzer::nextCardEquity(const std::vector<Card>& holeCards,
+                                            const std::vector<Card>& board,
+                                            const Range& villain) {
+    validate(holeCards, board);
+
+    Range hero;
+    hero.setWeight(holeCards[0], holeCards[1], 1.0f);
+    HandStrengthDistribution dist(board, hero, villain, 1);
+
+    uint8_t full[5];
+    for (size_t i = 0; i < board.size(); ++i) {
+        full[i] = board[i].getIndex();
+    }
+    uint64_t dead = Range::cardMask(holeCards) | Range::cardMask(board);
+    std::vector<uint8_t> live;
+    for (uint8_t card = 0; card < 52; ++card) {
+        if (!(dead & (uint64_t(1) << card))) live.push_back(card);
+    }
+
+    HandStrengthDistribution::Scratch scratch;
+    auto shareOn = [&](uint8_t turn, uint8_t river) {
+        full[3] = turn;
+        full[4] = river;
+        ShowdownShare share;
+        dist.riverShares(full, &share, scratch);
+        return share;
+    };
+
+    // Sum weighted wins and seen weight over runouts and divide once, so
+    // runouts that block more of the villain range count for less
+    NextCardEquity result;
+    result.next.fill(-1.0f);
+    ShowdownShare total;
+
+    if (board.size() == 4) {
+        for (uint8_t river : live) {
+            ShowdownShare share = shareOn(full[3], river);
+            result.next[river] = share.equity();
+            total += share;
+        }
+    } else {
+        // Each (turn, river) board is evaluated once and shared by both orders
+        std::vector<ShowdownShare> pair(52 * 52);
+        for (size_t t = 0; t < live.size(); ++t) {
+            for (size_t r = t + 1; r < live.size(); ++r) {
+                ShowdownShare share = shareOn(live[t], live[r]);
+                pair[live[t] * 52 + live[r]] = share;
+                pair[live[r] * 52 + live[t]] = share;
+            }
+        }
+        for (uint8_t turn : live) {
+            ShowdownShare turnTotal;
+            for (uint8_t river : live) {
+                if (river != turn) turnTotal += pair[turn * 52 + river];
+            }
+            result.next[turn] = turnTotal.equity();
+            total += turnTotal;
+        }
+    }
+
+    result.current = total.equity();
+    return result;
+}
+
+} // namespace poker
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Card.h"
+#include "HandEvaluation.h"
+#include "Range.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace poker {
+
+// Cards that improve a hand, grouped by the category they make
+struct OutsResult {
+    HandRank current;
+    uint64_t live;                         // Unseen cards, bit = Card::getIndex()
+    std::array<uint64_t, 11> byCategory;   // Outs indexed by resulting HandRank
+
+    uint64_t outs(HandRank rank) const { return byCategory[static_cast<uint8_t>(rank)]; }
+    uint64_t allOuts() const;
+
+    size_t count(HandRank rank) const;
+    size_t total() const;
+};
+
+// Equity against a range before and after the next card
+struct NextCardEquity {
+    float current;
+    std::array<float, 52> next;            // -1 for cards that cannot come
+
+    float change(uint8_t card) const { return next[card] - current; }
+};
+
+// Outs and draw analysis for a hold'em hand on the flop or turn.
+//
+// An out is an unseen card that lifts the hand to a higher category than it
+// has now, and higher than the board plus that card shows on its own, using
+// a hole card: a card that only pairs the board is never an out. Rank
+// improvements come from multiplicity masks (ranks seen at least 1-4 times)
+// and a straight lookup on the rank mask; flush draws from suit counts. The
+// evaluator is consulted only for cards that both complete a flush and make
+// a straight or better by rank, where the categories interact.
+class OutsAnalyzer {
+public:
+    // hole: 2 cards, board: 3 or 4 cards
+    static OutsResult outs(const std::vector<Card>& holeCards,
+                           const std::vector<Card>& board);
+
+    // All-in equity against villain now and after each possible next card
+    static NextCardEquity nextCardEquity(const std::vector<Card>& holeCards,
+                                         const std::vector<Card>& board,
+                                         const Range& villain);
+};
+
+} // namespace poker
@@ -0,0 +1,342 @@
+#include "Range.h"
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+namespace poker {
+
+namespace {
+
+struct ComboTables {
+    uint8_t cards[Range::NUM_COMBOS][2];     // Card indices, higher first
+    uint16_t cardCombos[52][51];             // Combos containing each card
+};
+
+constexpr ComboTables makeComboTables() {
+    ComboTables tables{};
+    uint8_t filled[52] = {};
+    size_t combo = 0;
+    for (uint8_t hi = 1; hi < 52; ++hi) {
+        for (uint8_t lo = 0; lo < hi; ++lo) {
+            tables.cards[combo][0] = hi;
+            tables.cards[combo][1] = lo;
+            tables.cardCombos[hi][filled[hi]++] = static_cast<uint16_t>(combo);
+            tables.cardCombos[lo][filled[lo]++] = static_cast<uint16_t>(combo);
+            ++combo;
+        }
+    }
+    return tables;
+}
+
+constexpr ComboTables kTables = makeComboTables();
+
+bool isSeparator(char c) {
+    return c == ',' || c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool isSuitChar(char c) {
+    return c == 'c' || c == 'd' || c == 'h' || c == 's' ||
+           c == 'C' || c == 'D' || c == 'H' || c == 'S';
+}
+
+enum class Suitedness { ANY, SUITED, OFFSUIT };
+
+// Two ranks (hi >= lo) plus a suited/offsuit qualifier, e.g. "AKs", "QQ"
+struct HandClass {
+    uint8_t hi;
+    uint8_t lo;
+    Suitedness suitedness;
+};
+
+[[noreturn]] void invalidToken(const char* token, size_t len) {
+    throw std::invalid_argument("Invalid range token: " + std::string(token, len));
+}
+
+// Parse a hand class at token[pos]; advances pos past it
+HandClass parseHandClass(const char* token, size_t len, size_t& pos) {
+    if (pos + 2 > len) invalidToken(token, len);
+
+    uint8_t a = static_cast<uint8_t>(Card::parseRank(token[pos]));
+    uint8_t b = static_cast<uint8_t>(Card::parseRank(token[pos + 1]));
+    pos += 2;
+
+    HandClass hand{a > b ? a : b, a > b ? b : a, Suitedness::ANY};
+    if (pos < len && (token[pos] == 's' || token[pos] == 'S')) {
+        hand.suitedness = Suitedness::SUITED;
+        ++pos;
+    } else if (pos < len && (token[pos] == 'o' || token[pos] == 'O')) {
+        hand.suitedness = Suitedness::OFFSUIT;
+        ++pos;
+    }
+    if (hand.hi == hand.lo && hand.suitedness != Suitedness::ANY) {
+        invalidToken(token, len);
+    }
+    return hand;
+}
+
+void addHandClass(Range& range, uint8_t hi, uint8_t lo, Suitedness suitedness, float weight) {
+    for (uint8_t s1 = 0; s1 < 4; ++s1) {
+        for (uint8_t s2 = 0; s2 < 4; ++s2) {
+            if (hi == lo ? s1 >= s2
+                         : (suitedness == Suitedness::SUITED && s1 != s2) ||
+                           (suitedness == Suitedness::OFFSUIT && s1 == s2)) {
+                continue;
+            }
+            uint8_t c1 = static_cast<uint8_t>((hi - 2) * 4 + s1);
+            uint8_t c2 = static_cast<uint8_t>((lo - 2) * 4 + s2);
+            range[Range::comboIndex(c1, c2)] = weight;
+        }
+    }
+}
+
+void parseToken(Range& range, const char* token, size_t len) {
+    // Optional ":weight" suffix
+    float weight = 1.0f;
+    size_t bodyLen = len;
+    for (size_t i = 0; i < len; ++i) {
+        if (token[i] == ':') {
+            char* end = nullptr;
+            weight = std::strtof(token + i + 1, &end);
+            if (end != token + len || i + 1 == len || !std::isfinite(weight) || weight < 0.0f) {
+                invalidToken(token, len);
+            }
+            bodyLen = i;
+            break;
+        }
+    }
+
+    // Specific combo, e.g. "AhKh"
+    if (bodyLen == 4 && isSuitChar(token[1]) && isSuitChar(token[3])) {
+        Card a(Card::parseRank(token[0]), Card::parseSuit(token[1]));
+        Card b(Card::parseRank(token[2]), Card::parseSuit(token[3]));
+        if (a == b) invalidToken(token, len);
+        range.setWeight(a, b, weight);
+        return;
+    }
+
+    size_t pos = 0;
+    HandClass first = parseHandClass(token, bodyLen, pos);
+
+    if (pos == bodyLen) {
+        addHandClass(range, first.hi, first.lo, first.suitedness, weight);
+    } else if (token[pos] == '+' && pos + 1 == bodyLen) {
+        // "QQ+" climbs pairs to AA; "A2s+" climbs the kicker below the top card
+        if (first.hi == first.lo) {
+            for (uint8_t r = first.lo; r <= 14; ++r) {
+                addHandClass(range, r, r, first.suitedness, weight);
+            }
+        } else {
+            for (uint8_t r = first.lo; r < first.hi; ++r) {
+                addHandClass(range, first.hi, r, first.suitedness, weight);
+            }
+        }
+    } else if (token[pos] == '-') {
+        ++pos;
+        HandClass last = parseHandClass(token, bodyLen, pos);
+        if (pos != bodyLen || last.suitedness != first.suitedness) {
+            invalidToken(token, len);
+        }
+
+        bool firstPair = first.hi == first.lo;
+        bool lastPair = last.hi == last.lo;
+        if (firstPair && lastPair) {
+            // "22-55"
+            uint8_t from = first.hi < last.hi ? first.hi : last.hi;
+            uint8_t to = first.hi < last.hi ? last.hi : first.hi;
+            for (uint8_t r = from; r <= to; ++r) {
+                addHandClass(range, r, r, first.suitedness, weight);
+            }
+        } else if (!firstPair && !lastPair && first.hi == last.hi) {
+            // "A5s-A2s": same top card, kicker range
+            uint8_t from = first.lo < last.lo ? first.lo : last.lo;
+            uint8_t to = first.lo < last.lo ? last.lo : first.lo;
+            for (uint8_t r = from; r <= to; ++r) {
+                addHandClass(range, first.hi, r, first.suitedness, weight);
+            }
+        } else if (!firstPair && !lastPair && first.hi - first.lo == last.hi - last.lo) {
+            // "T9s-76s": both cards step down together
+            const HandClass& top = first.hi > last.hi ? first : last;
+            const HandClass& bottom = first.hi > last.hi ? last : first;
+            for (uint8_t shift = 0; shift <= top.hi - bottom.hi; ++shift) {
+                addHandClass(range, static_cast<uint8_t>(top.hi - shift),
+                             static_cast<uint8_t>(top.lo - shift), first.suitedness, weight);
+            }
+        } else {
+            invalidToken(token, len);
+        }
+    } else {
+        invalidToken(token, len);
+    }
+}
+
+} // namespace
+
+Range::Range() : weights_{} {}
+
+Range Range::full() {
+    Range range;
+    for (size_t i = 0; i < NUM_COMBOS; ++i) {
+        range.weights_[i] = 1.0f;
+    }
+    return range;
+}
+
+Range Range::parse(const std::string& str) {
+    Range range;
+    const char* text = str.c_str();
+    size_t i = 0;
+    size_t n = str.size();
+
+    while (i < n) {
+        if (isSeparator(text[i])) {
+            ++i;
+            continue;
+        }
+        size_t start = i;
+        while (i < n && !isSeparator(text[i])) ++i;
+        parseToken(range, text + start, i - start);
+    }
+    return range;
+}
+
+size_t Range::comboIndex(const Card& a, const Card& b) {
+    return comboIndex(a.getIndex(), b.getIndex());
+}
+
+size_t Range::comboIndex(uint8_t cardA, uint8_t cardB) {
+    uint8_t hi = cardA > cardB ? cardA : cardB;
+    uint8_t lo = cardA > cardB ? cardB : cardA;
+    return size_t(hi) * (hi - 1) / 2 + lo;
+}
+
+std::pair<uint8_t, uint8_t> Range::comboCards(size_t combo) {
+    return {kTables.cards[combo][0], kTables.cards[combo][1]};
+}
+
+uint64_t Range::cardMask(const std::vector<Card>& cards) {
+    uint64_t mask = 0;
+    for (const auto& card : cards) {
+        mask |= uint64_t(1) << card.getIndex();
+    }
+    return mask;
+}
+
+float Range::weight(const Card& a, const Card& b) const {
+    return weights_[comboIndex(a, b)];
+}
+
+void Range::setWeight(const Card& a, const Card& b, float weight) {
+    weights_[comboIndex(a, b)] = weight;
+}
+
+float Range::sum() const {
+#if defined(__SSE__)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    for (size_t i = 0; i < PADDED_SIZE; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_load_ps(&weights_[i]));
+        acc1 = _mm_add_ps(acc1, _mm_load_ps(&weights_[i + 4]));
+    }
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, _mm_add_ps(acc0, acc1));
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#else
+    float total = 0.0f;
+    for (size_t i = 0; i < PADDED_SIZE; ++i) {
+        total += weights_[i];
+    }
+    return total;
+#endif
+}
+
+void Range::normalize() {
+    float total = sum();
+    if (total > 0.0f) {
+        *this *= 1.0f / total;
+    }
+}
+
+void Range::removeBlocked(uint64_t deadCards) {
+    while (deadCards) {
+        int card = __builtin_ctzll(deadCards);
+        deadCards &= deadCards - 1;
+        for (uint16_t combo : kTables.cardCombos[card]) {
+            weights_[combo] = 0.0f;
+        }
+    }
+}
+
+void Range::removeBlocked(const std::vector<Card>& board) {
+    removeBlocked(cardMask(board));
+}
+
+Range& Range::operator*=(const Range& other) {
+#if defined(__SSE__)
+    for (size_t i = 0; i < PADDED_SIZE; i += 4) {
+        _mm_store_ps(&weights_[i], _mm_mul_ps(_mm_load_ps(&weights_[i]),
+                                              _mm_load_ps(&other.weights_[i])));
+    }
+#else
+    for (size_t i = 0; i < PADDED_SIZE; ++i) {
+        weights_[i] *= other.weights_[i];
+    }
+#endif
+    return *this;
+}
+
+Range& Range::operator*=(float scale) {
+#if defined(__SSE__)
+    __m128 factor = _mm_set1_ps(scale);
+    for (size_t i = 0; i < PADDED_SIZE; i += 4) {
+        _mm_store_ps(&weights_[i], _mm_mul_ps(_mm_load_ps(&weights_[i]), factor));
+    }
+#else
+    for (size_t i = 0; i < PADDED_SIZE; ++i) {
+        weights_[i] *= scale;
+    }
+#endif
+    return *this;
+}
+
+Range& Range::operator+=(const Range& other) {
+#if defined(__SSE__)
+    for (size_t i = 0; i < PADDED_SIZE; i += 4) {
+        _mm_store_ps(&weights_[i], _mm_add_ps(_mm_load_ps(&weights_[i]),
+                                              _mm_load_ps(&other.weights_[i])));
+    }
+#else
+    for (size_t i = 0; i < PADDED_SIZE; ++i) {
+        weights_[i] += other.weights_[i];
+    }
+#endif
+    return *this;
+}
+
+std::array<float, 52> Range::cardReach() const {
+    std::array<float, 52> reach{};
+    for (size_t i = 0; i < NUM_COMBOS; ++i) {
+        reach[kTables.cards[i][0]] += weights_[i];
+        reach[kTables.cards[i][1]] += weights_[i];
+    }
+    return reach;
+}
+
+Range Range::compatibleReach() const {
+    // Inclusion-exclusion: combos sharing a card with (a, b) are those holding
+    // a or b; the combo (a, b) itself is subtracted twice so add it back
+    auto reach = cardReach();
+    float total = sum();
+
+    Range result;
+    for (size_t i = 0; i < NUM_COMBOS; ++i) {
+        result.weights_[i] = total - reach[kTables.cards[i][0]] -
+                             reach[kTables.cards[i][1]] + weights_[i];
+    }
+    return result;
+}
+
+} // namespace poker
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Card.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace poker {
+
+// Dense weight vector over the 1326 hole-card combos.
+//
+// Combos are ordered by card index (Card::getIndex): the combo of cards
+// hi > lo lives at hi * (hi - 1) / 2 + lo. Weights are stored in an aligned
+// float array padded to a multiple of the SIMD width; padding stays zero.
+class Range {
+public:
+    static constexpr size_t NUM_COMBOS = 1326;
+    static constexpr size_t PADDED_SIZE = 1328;
+
+    // Empty range (all weights zero)
+    Range();
+
+    // Every combo with weight 1
+    static Range full();
+
+    // Parse standard range syntax, e.g. "AKs, QQ+, T9s-76s, A5s-A2s:0.5, AhKh".
+    // Tokens are separated by commas or whitespace; ":w" sets a weight.
+    static Range parse(const std::string& str);
+
+    // Combo index for two distinct cards (order does not matter)
+    static size_t comboIndex(const Card& a, const Card& b);
+    static size_t comboIndex(uint8_t cardA, uint8_t cardB);
+
+    // Card indices of a combo, higher index first
+    static std::pair<uint8_t, uint8_t> comboCards(size_t combo);
+
+    // Bitmask with bit Card::getIndex() set for each card
+    static uint64_t cardMask(const std::vector<Card>& cards);
+
+    float operator[](size_t combo) const { return weights_[combo]; }
+    float& operator[](size_t combo) { return weights_[combo]; }
+
+    float weight(const Card& a, const Card& b) const;
+    void setWeight(const Card& a, const Card& b, float weight);
+
+    const float* data() const { return weights_.data(); }
+    float* data() { return weights_.data(); }
+
+    // Total weight of all combos
+    float sum() const;
+
+    // Scale weights to sum to 1 (no-op on an empty range)
+    void normalize();
+
+    // Zero every combo containing a dead card
+    void removeBlocked(uint64_t deadCards);
+    void removeBlocked(const std::vector<Card>& board);
+
+    // Elementwise product, e.g. reach times strategy
+    Range& operator*=(const Range& other);
+    Range& operator*=(float scale);
+    Range& operator+=(const Range& other);
+
+    // Total weight of combos containing each card, indexed by card index
+    std::array<float, 52> cardReach() const;
+
+    // For each combo, the weight of this range that shares no card with it
+    // (card-removal corrected opponent reach)
+    Range compatibleReach() const;
+
+private:
+    alignas(32) std::array<float, PADDED_SIZE> weights_;
+};
+
+} // namespace poker
@@ -0,0 +1,337 @@
+#include "ShardedSolve.h"
+#include "HandStrengthDistribution.h"
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace poker {
+
+namespace {
+
+struct WorkerProcess {
+    pid_t pid;
+    int fd;   // Socket to the worker: go byte in, status byte (+ error text) out
+};
+
+// Sends never raise SIGPIPE: a peer that died shows up as EPIPE instead
+bool sendAll(int fd, const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t n = send(fd, bytes, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        bytes += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Returns false on EOF or error
+bool recvAll(int fd, void* data, size_t size) {
+    char* bytes = static_cast<char*>(data);
+    while (size > 0) {
+        ssize_t n = recv(fd, bytes, size, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        bytes += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Failure report: nonzero status, then the length-prefixed exception text
+bool sendFailure(int fd, const std::string& what) {
+    uint8_t status = 1;
+    uint32_t length = static_cast<uint32_t>(std::min<size_t>(what.size(), 4096));
+    return sendAll(fd, &status, 1) && sendAll(fd, &length, sizeof(length)) &&
+           sendAll(fd, what.data(), length);
+}
+
+// Reads one iteration's status; returns false with the reason on failure
+bool receiveStatus(int fd, std::string& error) {
+    uint8_t status;
+    if (!recvAll(fd, &status, 1)) {
+        error = "exited";
+        return false;
+    }
+    if (status == 0) return true;
+    uint32_t length = 0;
+    if (!recvAll(fd, &length, sizeof(length)) || length > 4096) {
+        error = "failed";
+        return false;
+    }
+    error.assign(length, '\0');
+    if (!recvAll(fd, &error[0], length)) error = "failed";
+    return false;
+}
+
+void stopWorkers(std::vector<WorkerProcess>& workers, bool kill) {
+    for (auto& worker : workers) {
+        close(worker.fd);
+        if (kill) ::kill(worker.pid, SIGKILL);
+    }
+    for (auto& worker : workers) {
+        int status;
+        waitpid(worker.pid, &status, 0);
+    }
+    workers.clear();
+}
+
+template <typename T>
+void writeVector(std::ofstream& out, const std::vector<T>& values) {
+    uint64_t size = values.size();
+    out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    out.write(reinterpret_cast<const char*>(values.data()), size * sizeof(T));
+}
+
+template <typename T>
+void readVector(std::ifstream& in, std::vector<T>& values) {
+    uint64_t size = 0;
+    in.read(reinterpret_cast<char*>(&size), sizeof(size));
+    values.resize(size);
+    in.read(reinterpret_cast<char*>(values.data()), size * sizeof(T));
+}
+
+} // namespace
+
+void SolveCheckpoint::save(const std::string& path) const {
+    // Write then rename so readers never see a partial checkpoint
+    std::string temp = path + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        out.write("SCK1", 4);
+        out.write(reinterpret_cast<const char*>(&iteration), sizeof(iteration));
+        writeVector(out, cards);
+        writeVector(out, boundary);
+        writeVector(out, regrets);
+        if (!out) throw std::runtime_error("Cannot write checkpoint: " + temp);
+    }
+    if (std::rename(temp.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Cannot write checkpoint: " + path);
+    }
+}
+
+SolveCheckpoint SolveCheckpoint::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[4] = {};
+    in.read(magic, 4);
+    if (!in || std::memcmp(magic, "SCK1", 4) != 0) {
+        throw std::runtime_error("Not a solve checkpoint: " + path);
+    }
+
+    SolveCheckpoint checkpoint;
+    in.read(reinterpret_cast<char*>(&checkpoint.iteration), sizeof(checkpoint.iteration));
+    readVector(in, checkpoint.cards);
+    readVector(in, checkpoint.boundary);
+    readVector(in, checkpoint.regrets);
+    if (!in) throw std::runtime_error("Truncated checkpoint: " + path);
+    return checkpoint;
+}
+
+ShardedSolver::ShardedSolver(const ShardedSolveConfig& config) : config_(config) {
+    if (config.board.size() != 3 && config.board.size() != 4) {
+        throw std::invalid_argument("Sharded solve board must have 3 or 4 cards");
+    }
+    if (config.workers == 0) {
+        throw std::invalid_argument("Sharded solve needs at least one worker");
+    }
+
+    uint64_t dead = Range::cardMask(config.board);
+    for (uint8_t card = 0; card < 52; ++card) {
+        if (!(dead & (uint64_t(1) << card))) cards_.push_back(card);
+    }
+}
+
+unsigned ShardedSolver::ownerOf(size_t subtree) const {
+    return static_cast<unsigned>(subtree % config_.workers);
+}
+
+SolveCheckpoint ShardedSolver::run(const SubtreeTask& task) const {
+    const size_t subtrees = cards_.size();
+    const size_t boundarySize = config_.boundarySize;
+    const size_t regretSize = config_.regretSize;
+    const unsigned workerCount = config_.workers;
+
+    // Segment layout: boundary[subtree][boundarySize] | regrets[regretSize]
+    //                 | deltas[worker][regretSize]
+    size_t floats = subtrees * boundarySize + regretSize * (1 + workerCount);
+    size_t bytes = std::max<size_t>(floats * sizeof(float), 1);
+    void* segment = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (segment == MAP_FAILED) {
+        throw std::runtime_error(std::string("mmap: ") + std::strerror(errno));
+    }
+    float* boundary = static_cast<float*>(segment);
+    float* regrets = boundary + subtrees * boundarySize;
+    float* deltas = regrets + regretSize;
+
+    // Children must not flush buffered output a second time
+    std::fflush(nullptr);
+
+    std::vector<WorkerProcess> workers;
+    for (unsigned shard = 0; shard < workerCount; ++shard) {
+        int channel[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, channel) != 0) {
+            stopWorkers(workers, true);
+            munmap(segment, bytes);
+            throw std::runtime_error(std::string("socketpair: ") + std::strerror(errno));
+        }
+
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(channel[0]);
+            for (const auto& other : workers) {
+                close(other.fd);
+            }
+
+            uint8_t token;
+            for (uint32_t iteration = 0; iteration < config_.iterations; ++iteration) {
+                if (!recvAll(channel[1], &token, 1)) _exit(1);
+                std::string error;
+                try {
+                    for (size_t s = shard; s < subtrees; s += workerCount) {
+                        task({iteration, shard, cards_[s], regrets, boundary + s * boundarySize,
+                              boundarySize, deltas + shard * regretSize});
+                    }
+                } catch (const std::exception& e) {
+                    error = e.what();
+                    if (error.empty()) error = "unknown error";
+                } catch (...) {
+                    error = "unknown error";
+                }
+                if (!error.empty()) {
+                    sendFailure(channel[1], error);
+                    _exit(1);
+                }
+                uint8_t status = 0;
+                if (!sendAll(channel[1], &status, 1)) _exit(1);
+            }
+            _exit(0);
+        }
+
+        close(channel[1]);
+        if (pid < 0) {
+            close(channel[0]);
+            stopWorkers(workers, true);
+            munmap(segment, bytes);
+            throw std::runtime_error(std::string("fork: ") + std::strerror(errno));
+        }
+        workers.push_back({pid, channel[0]});
+    }
+
+    SolveCheckpoint checkpoint;
+    checkpoint.cards = cards_;
+    for (uint32_t iteration = 0; iteration < config_.iterations; ++iteration) {
+        // Keep the first failure, but collect every status so no worker is
+        // left mid-iteration
+        std::string failure;
+        std::vector<bool> started(workerCount);
+        const uint8_t token = 1;
+        for (unsigned shard = 0; shard < workerCount; ++shard) {
+            started[shard] = sendAll(workers[shard].fd, &token, 1);
+            if (!started[shard] && failure.empty()) {
+                failure = "shard " + std::to_string(shard) + " exited";
+            }
+        }
+        for (unsigned shard = 0; shard < workerCount; ++shard) {
+            std::string error;
+            if (started[shard] && !receiveStatus(workers[shard].fd, error) && failure.empty()) {
+                failure = "shard " + std::to_string(shard) + ": " + error;
+            }
+        }
+        if (!failure.empty()) {
+            stopWorkers(workers, true);
+            munmap(segment, bytes);
+            throw std::runtime_error("Sharded solve worker failed in iteration " +
+                                     std::to_string(iteration) + ": " + failure);
+        }
+
+        // Every worker is parked on its go pipe: fold deltas into the regrets
+        for (unsigned shard = 0; shard < workerCount; ++shard) {
+            float* delta = deltas + shard * regretSize;
+            for (size_t i = 0; i < regretSize; ++i) {
+                regrets[i] += delta[i];
+                delta[i] = 0.0f;
+            }
+        }
+
+        checkpoint.iteration = iteration + 1;
+        checkpoint.boundary.assign(boundary, boundary + subtrees * boundarySize);
+        checkpoint.regrets.assign(regrets, regrets + regretSize);
+        if (!config_.checkpointPath.empty()) {
+            try {
+                checkpoint.save(config_.checkpointPath);
+            } catch (...) {
+                stopWorkers(workers, true);
+                munmap(segment, bytes);
+                throw;
+            }
+        }
+    }
+
+    stopWorkers(workers, false);
+    munmap(segment, bytes);
+    return checkpoint;
+}
+
+ShardedSolver::SubtreeTask showdownBoundaryTask(const std::vector<Card>& board,
+                                                const Range& hero, const Range& villain) {
+    auto dist = std::make_shared<HandStrengthDistribution>(board, hero, villain, 1);
+    std::vector<uint8_t> boardCards;
+    for (const auto& card : board) {
+        boardCards.push_back(card.getIndex());
+    }
+
+    return [dist, boardCards](const SubtreeContext& context) {
+        if (context.boundarySize < Range::NUM_COMBOS) {
+            throw std::invalid_argument("Showdown boundary needs boundarySize >= NUM_COMBOS");
+        }
+
+        // Weighted shares summed over rivers, divided once at the end
+        const auto& combos = dist->combos();
+        std::vector<ShowdownShare> total(combos.size());
+        std::vector<ShowdownShare> shares(combos.size());
+        HandStrengthDistribution::Scratch scratch;
+
+        uint8_t full[5];
+        std::copy(boardCards.begin(), boardCards.end(), full);
+        full[boardCards.size()] = context.card;
+
+        auto addRiver = [&]() {
+            dist->riverShares(full, shares.data(), scratch);
+            for (size_t slot = 0; slot < combos.size(); ++slot) {
+                total[slot] += shares[slot];
+            }
+        };
+
+        if (boardCards.size() == 4) {
+            addRiver();
+        } else {
+            uint64_t dead = uint64_t(1) << context.card;
+            for (uint8_t card : boardCards) {
+                dead |= uint64_t(1) << card;
+            }
+            for (uint8_t river = 0; river < 52; ++river) {
+                if (dead & (uint64_t(1) << river)) continue;
+                full[4] = river;
+                addRiver();
+            }
+        }
+
+        std::fill(context.boundary, context.boundary + Range::NUM_COMBOS, -1.0f);
+        for (size_t slot = 0; slot < combos.size(); ++slot) {
+            context.boundary[combos[slot]] = total[slot].equity();
+        }
+    };
+}
+
+} // namespace poker
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Card.h"
+#include "Range.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace poker {
+
+struct ShardedSolveConfig {
+    std::vector<Card> board;      // 3 or 4 cards; subtrees split on the next card
+    unsigned workers = 2;         // Worker processes
+    unsigned iterations = 1;
+    size_t boundarySize = 0;      // Floats of boundary values per subtree
+    size_t regretSize = 0;        // Floats of regrets shared by all subtrees
+    std::string checkpointPath;   // Written after every iteration if set
+};
+
+// Merged state the coordinator publishes after each iteration
+struct SolveCheckpoint {
+    uint32_t iteration = 0;
+    std::vector<uint8_t> cards;      // Chance card of each subtree
+    std::vector<float> boundary;     // cards.size() x boundarySize
+    std::vector<float> regrets;      // Sum of every worker's deltas so far
+
+    void save(const std::string& path) const;
+    static SolveCheckpoint load(const std::string& path);
+};
+
+// What a worker sees while solving one subtree for one iteration
+struct SubtreeContext {
+    uint32_t iteration;
+    unsigned shard;
+    uint8_t card;                 // Chance card rooting this subtree
+    const float* regrets;         // Merged regrets from earlier iterations
+    float* boundary;              // This subtree's boundary values (write)
+    size_t boundarySize;          // Floats available at boundary
+    float* regretDelta;           // This worker's regret deltas (accumulate)
+};
+
+// Multi-process solve partitioned by the next chance card.
+//
+// Subtrees below each live turn (or river) card are dealt round-robin to
+// worker processes. Boundary values and regret deltas live in one shared
+// memory segment; workers and the coordinator step through iterations in
+// lockstep over socket pairs. After every iteration the coordinator folds all
+// deltas into the merged regrets and writes a checkpoint.
+//
+// Workers only touch their own slots between barriers, so the segment can be
+// replaced by a socket transport carrying the same slots without changing
+// the iteration protocol.
+class ShardedSolver {
+public:
+    using SubtreeTask = std::function<void(const SubtreeContext&)>;
+
+    explicit ShardedSolver(const ShardedSolveConfig& config);
+
+    // Fork the workers, run every iteration and return the final checkpoint.
+    // Call from a single-threaded process. Throws std::runtime_error if a
+    // worker throws or dies; the message carries the worker's exception text.
+    SolveCheckpoint run(const SubtreeTask& task) const;
+
+    // Chance cards rooting each subtree, and the worker that owns each
+    const std::vector<uint8_t>& subtreeCards() const { return cards_; }
+    unsigned ownerOf(size_t subtree) const;
+
+private:
+    ShardedSolveConfig config_;
+    std::vector<uint8_t> cards_;
+};
+
+// Check-down boundary values: for each subtree card, every hero combo's
+// equity against the villain range averaged over the remaining runouts.
+// Boundary layout is one float per combo (Range ordering), -1 if blocked,
+// so the solve needs boundarySize >= Range::NUM_COMBOS; the task throws
+// std::invalid_argument otherwise.
+ShardedSolver::SubtreeTask showdownBoundaryTask(const std::vector<Card>& board,
+                                                const Range& hero, const Range& villain);
+
+} // namespace poker
@@ -0,0 +1,406 @@
+#pragma once
+
+#include "Card.h"
+#include "GameRules.h"
+#include "HandEvaluation.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace poker {
+
+// Hand evaluator specialized at compile time on a rules policy (see
+// GameRules.h). Hands are reduced to a packed 24-bit score:
+//
+//   bits 20-23  category strength (Rules::kCategoryStrength)
+//   bits 0-19   up to five 4-bit tiebreaker ranks, most significant first
+//
+// so comparing two scores compares the hands under the variant's rules.
+// HandResult ordering follows hold'em categories; compare short-deck hands
+// with score() or compare() rather than HandResult::operator<.
+template <typename Rules>
+class VariantEvaluator {
+public:
+    static constexpr uint8_t kMinRank = Rules::kMinRank;
+
+    // Packed strength of the best legal five-card hand. Throws
+    // std::invalid_argument unless there are Rules::kHoleCards hole cards and
+    // 3-5 community cards.
+    static uint32_t score(const std::vector<Card>& holeCards,
+                          const std::vector<Card>& community);
+
+    static HandResult evaluate(const std::vector<Card>& holeCards,
+                               const std::vector<Card>& community);
+
+    static CompareResult compare(const std::vector<Card>& holeCards1,
+                                 const std::vector<Card>& holeCards2,
+                                 const std::vector<Card>& community);
+
+    // Unpack a score into the category and tiebreakers HandEvaluator reports
+    static HandResult toHandResult(uint32_t score);
+
+    // All cards in this variant's deck
+    static std::vector<Card> deck();
+
+    // Packed strength of hole + board given as card indices (Card::getIndex);
+    // skips Card validation, for batch callers that already hold indices
+    static uint32_t scoreIndices(const uint8_t* cards, size_t count);
+
+    // Score from per-rank counts (indexed by rank value), the mask of ranks
+    // present (bit = rank value) and the ranks of a flush suit (0 if none)
+    static uint32_t scoreCounts(const uint8_t* counts, uint16_t rankMask,
+                                uint16_t flushMask);
+
+    // High card of the best straight in a rank mask, 0 if none
+    static uint8_t straightHigh(uint16_t rankMask) {
+        return kStraightHigh[rankMask >> kMinRank];
+    }
+
+private:
+    static constexpr int kTableBits = 15 - kMinRank;
+    using StraightTable = std::array<uint8_t, size_t(1) << kTableBits>;
+
+    static constexpr StraightTable makeStraightTable() {
+        StraightTable table{};
+        const uint32_t wheel = (1u << 14) | (0xFu << kMinRank);
+        for (uint32_t m = 0; m < table.size(); ++m) {
+            uint32_t ranks = m << kMinRank;
+            for (int high = 14; high >= kMinRank + 4; --high) {
+                uint32_t run = 0x1Fu << (high - 4);
+                if ((ranks & run) == run) {
+                    table[m] = static_cast<uint8_t>(high);
+                    break;
+                }
+            }
+            if (table[m] == 0 && (ranks & wheel) == wheel) {
+                table[m] = kMinRank + 3;
+            }
+        }
+        return table;
+    }
+
+    static constexpr StraightTable kStraightHigh = makeStraightTable();
+
+    static uint32_t category(HandRank rank) {
+        return uint32_t(Rules::kCategoryStrength[static_cast<uint8_t>(rank)]) << 20;
+    }
+
+    // Append the n highest ranks of mask as tiebreakers below shift
+    static uint32_t highest(uint16_t mask, int n, int shift) {
+        uint32_t packed = 0;
+        for (int r = 14; r >= kMinRank && n > 0; --r) {
+            if (mask & (1u << r)) {
+                packed |= uint32_t(r) << shift;
+                shift -= 4;
+                --n;
+            }
+        }
+        return packed;
+    }
+
+    static void checkCard(const Card& card) {
+        if constexpr (kMinRank > 2) {
+            if (card.getRankValue() < kMinRank) {
+                throw std::invalid_argument("Card not in deck for this variant: " +
+                                            card.toString());
+            }
+        }
+    }
+
+    static uint32_t scoreSuits(const uint8_t* counts, uint16_t rankMask,
+                               const uint16_t* suitMasks);
+    static uint32_t scoreAny(const std::vector<Card>& holeCards,
+                             const std::vector<Card>& community);
+    static uint32_t scoreExactlyTwo(const std::vector<Card>& holeCards,
+                                    const std::vector<Card>& community);
+};
+
+using HoldemEvaluator = VariantEvaluator<HoldemRules>;
+using ShortDeckEvaluator = VariantEvaluator<ShortDeckRules>;
+using OmahaEvaluator = VariantEvaluator<OmahaRules>;
+
+template <typename Rules>
+uint32_t VariantEvaluator<Rules>::scoreCounts(const uint8_t* counts, uint16_t rankMask,
+                                              uint16_t flushMask) {
+    uint32_t best = 0;
+
+    if (flushMask) {
+        uint8_t high = straightHigh(flushMask);
+        if (high == 14) {
+            return category(HandRank::ROYAL_FLUSH) | (14u << 16);
+        } else if (high) {
+            return category(HandRank::STRAIGHT_FLUSH) | (uint32_t(high) << 16);
+        }
+        best = category(HandRank::FLUSH) | highest(flushMask, 5, 16);
+    }
+
+    uint8_t quad = 0;
+    uint8_t trips[2] = {0, 0};
+    uint8_t pairs[2] = {0, 0};
+    for (int r = 14; r >= kMinRank; --r) {
+        uint8_t c = counts[r];
+        if (c >= 4) {
+            if (!quad) quad = static_cast<uint8_t>(r);
+        } else if (c == 3) {
+            if (!trips[0]) trips[0] = static_cast<uint8_t>(r);
+            else if (!trips[1]) trips[1] = static_cast<uint8_t>(r);
+        } else if (c == 2) {
+            if (!pairs[0]) pairs[0] = static_cast<uint8_t>(r);
+            else if (!pairs[1]) pairs[1] = static_cast<uint8_t>(r);
+        }
+    }
+
+    uint32_t candidate;
+    if (quad) {
+        candidate = category(HandRank::FOUR_OF_A_KIND) | (uint32_t(quad) << 16) |
+                    highest(rankMask & ~(1u << quad), 1, 12);
+        if (candidate > best) best = candidate;
+    }
+    if (trips[0] && (trips[1] || pairs[0])) {
+        uint8_t pairRank = trips[1] > pairs[0] ? trips[1] : pairs[0];
+        candidate = category(HandRank::FULL_HOUSE) | (uint32_t(trips[0]) << 16) |
+                    (uint32_t(pairRank) << 12);
+        if (candidate > best) best = candidate;
+    }
+    if (uint8_t high = straightHigh(rankMask)) {
+        candidate = category(HandRank::STRAIGHT) | (uint32_t(high) << 16);
+        if (candidate > best) best = candidate;
+    }
+    if (trips[0]) {
+        candidate = category(HandRank::THREE_OF_A_KIND) | (uint32_t(trips[0]) << 16) |
+                    highest(rankMask & ~(1u << trips[0]), 2, 12);
+        if (candidate > best) best = candidate;
+    }
+    if (pairs[1]) {
+        candidate = category(HandRank::TWO_PAIR) | (uint32_t(pairs[0]) << 16) |
+                    (uint32_t(pairs[1]) << 12) |
+                    highest(rankMask & ~((1u << pairs[0]) | (1u << pairs[1])), 1, 8);
+        if (candidate > best) best = candidate;
+    }
+    if (pairs[0]) {
+        candidate = category(HandRank::PAIR) | (uint32_t(pairs[0]) << 16) |
+                    highest(rankMask & ~(1u << pairs[0]), 3, 12);
+        if (candidate > best) best = candidate;
+    }
+    candidate = category(HandRank::HIGH_CARD) | highest(rankMask, 5, 16);
+    if (candidate > best) best = candidate;
+
+    return best;
+}
+
+template <typename Rules>
+uint32_t VariantEvaluator<Rules>::score(const std::vector<Card>& holeCards,
+                                        const std::vector<Card>& community) {
+    if constexpr (Rules::kHoleUsage == HoleUsage::EXACTLY_TWO) {
+        return scoreExactlyTwo(holeCards, community);
+    } else {
+        return scoreAny(holeCards, community);
+    }
+}
+
+template <typename Rules>
+uint32_t VariantEvaluator<Rules>::scoreAny(const std::vector<Card>& holeCards,
+                                           const std::vector<Card>& community) {
+    if (holeCards.size() != Rules::kHoleCards || community.size() < 3 || community.size() > 5) {
+        throw std::invalid_argument("Need " + std::to_string(Rules::kHoleCards) +
+                                    " hole cards and 3-5 community cards");
+    }
+
+    uint8_t counts[15] = {0};
+    uint16_t rankMask = 0;
+    uint16_t suitMasks[4] = {0, 0, 0, 0};
+    for (const auto* cards : {&holeCards, &community}) {
+        for (const auto& card : *cards) {
+            checkCard(card);
+            uint8_t r = card.getRankValue();
+            counts[r]++;
+            rankMask |= static_cast<uint16_t>(1u << r);
+            suitMasks[static_cast<uint8_t>(card.getSuit())] |= static_cast<uint16_t>(1u << r);
+        }
+    }
+
+    return scoreSuits(counts, rankMask, suitMasks);
+}
+
+template <typename Rules>
+uint32_t VariantEvaluator<Rules>::scoreIndices(const uint8_t* cards, size_t count) {
+    static_assert(Rules::kHoleUsage == HoleUsage::ANY,
+                  "scoreIndices does not apply hole card constraints");
+    static_assert(Rules::kMinRank == 2,
+                  "scoreIndices does not reject cards outside a short deck");
+
+    uint8_t counts[15] = {0};
+    uint16_t rankMask = 0;
+    uint16_t suitMasks[4] = {0, 0, 0, 0};
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t r = static_cast<uint8_t>(cards[i] / 4 + 2);
+        counts[r]++;
+        rankMask |= static_cast<uint16_t>(1u << r);
+        suitMasks[cards[i] % 4] |= static_cast<uint16_t>(1u << r);
+    }
+    return scoreSuits(counts, rankMask, suitMasks);
+}
+
+template <typename Rules>
+uint32_t VariantEvaluator<Rules>::scoreSuits(const uint8_t* counts, uint16_t rankMask,
+                                             const uint16_t* suitMasks) {
+    uint32_t best = 0;
+    bool anyFlush = false;
+    for (int s = 0; s < 4; ++s) {
+        if (__builtin_popcount(suitMasks[s]) >= 5) {
+            anyFlush = true;
+            uint32_t score = scoreCounts(counts, rankMask, suitMasks[s]);
+            if (score > best) best = score;
+        }
+    }
+    return anyFlush ? best : scoreCounts(counts, rankMask, 0);
+}
+
+template <typename Rules>
+uint32_t VariantEvaluator<Rules>::scoreExactlyTwo(const std::vector<Card>& holeCards,
+                                                  const std::vector<Card>& community) {
+    if (holeCards.size() != Rules::kHoleCards || community.size() < 3 || community.size() > 5) {
+        throw std::invalid_argument("Need " + std::to_string(Rules::kHoleCards) +
+                                    " hole cards and 3-5 community cards");
+    }
+
+    // Board work shared by every hole pair: each three-card board subset is
+    // reduced once to its ranks, rank mask and flush suit (-1 if mixed), and
+    // the whole board to rank counts and suited triples per suit
+    struct Part {
+        uint8_t ranks[3];
+        uint16_t mask;
+        int8_t suit;
+    };
+    Part triples[10];
+    size_t numTriples = 0;
+    uint8_t boardCounts[15] = {0};
+    uint16_t boardMask = 0;
+    uint16_t boardSuits[4] = {0, 0, 0, 0};
+    bool suitedTriple[4] = {false, false, false, false};
+    for (size_t a = 0; a < community.size(); ++a) {
+        checkCard(community[a]);
+        uint8_t rank = community[a].getRankValue();
+        boardCounts[rank]++;
+        boardMask |= static_cast<uint16_t>(1u << rank);
+        boardSuits[static_cast<uint8_t>(community[a].getSuit())] |= static_cast<uint16_t>(1u << rank);
+        for (size_t b = a + 1; b < community.size(); ++b) {
+            for (size_t c = b + 1; c < community.size(); ++c) {
+                const Card* cards[3] = {&community[a], &community[b], &community[c]};
+                Part& part = triples[numTriples++];
+                part.mask = 0;
+                part.suit = static_cast<int8_t>(cards[0]->getSuit());
+                for (int i = 0; i < 3; ++i) {
+                    part.ranks[i] = cards[i]->getRankValue();
+                    part.mask |= static_cast<uint16_t>(1u << part.ranks[i]);
+                    if (static_cast<int8_t>(cards[i]->getSuit()) != part.suit) {
+                        part.suit = -1;
+                    }
+                }
+                if (part.suit >= 0) suitedTriple[part.suit] = true;
+            }
+        }
+    }
+
+    uint32_t best = 0;
+    for (size_t i = 0; i < holeCards.size(); ++i) {
+        checkCard(holeCards[i]);
+        for (size_t j = i + 1; j < holeCards.size(); ++j) {
+            uint8_t r1 = holeCards[i].getRankValue();
+            uint8_t r2 = holeCards[j].getRankValue();
+            uint16_t pairMask = static_cast<uint16_t>((1u << r1) | (1u << r2));
+            int8_t pairSuit = holeCards[i].getSuit() == holeCards[j].getSuit()
+                                  ? static_cast<int8_t>(holeCards[i].getSuit())
+                                  : int8_t(-2);
+            bool canFlush = pairSuit >= 0 && suitedTriple[pairSuit];
+
+            // The pair plus the whole board scored as hold'em bounds every
+            // two-plus-three hand this pair makes: skip pairs that cannot win
+            uint8_t counts[15];
+            std::copy(boardCounts, boardCounts + 15, counts);
+            counts[r1]++;
+            counts[r2]++;
+            uint32_t bound = scoreCounts(counts, pairMask | boardMask,
+                                         canFlush ? (pairMask | boardSuits[pairSuit]) : 0);
+            if (bound <= best) continue;
+
+            std::fill(counts, counts + 15, 0);
+            counts[r1]++;
+            counts[r2]++;
+            for (size_t t = 0; t < numTriples && best < bound; ++t) {
+                const Part& part = triples[t];
+                counts[part.ranks[0]]++;
+                counts[part.ranks[1]]++;
+                counts[part.ranks[2]]++;
+
+                uint16_t rankMask = pairMask | part.mask;
+                uint32_t s = scoreCounts(counts, rankMask,
+                                         canFlush && part.suit == pairSuit ? rankMask : 0);
+                if (s > best) best = s;
+
+                counts[part.ranks[0]]--;
+                counts[part.ranks[1]]--;
+                counts[part.ranks[2]]--;
+            }
+        }
+    }
+    return best;
+}
+
+template <typename Rules>
+HandResult VariantEvaluator<Rules>::evaluate(const std::vector<Card>& holeCards,
+                                             const std::vector<Card>& community) {
+    return toHandResult(score(holeCards, community));
+}
+
+template <typename Rules>
+CompareResult VariantEvaluator<Rules>::compare(const std::vector<Card>& holeCards1,
+                                               const std::vector<Card>& holeCards2,
+                                               const std::vector<Card>& community) {
+    uint32_t hand1 = score(holeCards1, community);
+    uint32_t hand2 = score(holeCards2, community);
+
+    if (hand1 > hand2) return CompareResult::HAND1_WINS;
+    if (hand1 < hand2) return CompareResult::HAND2_WINS;
+    return CompareResult::TIE;
+}
+
+template <typename Rules>
+HandResult VariantEvaluator<Rules>::toHandResult(uint32_t score) {
+    // Tiebreakers HandEvaluator reports for each category, by HandRank value
+    static constexpr uint8_t kTiebreakerCount[11] = {0, 5, 4, 3, 3, 1, 5, 2, 2, 1, 1};
+
+    HandResult result;
+    result.rank = HandRank::HIGH_CARD;
+    uint8_t strength = static_cast<uint8_t>(score >> 20);
+    for (uint8_t r = 1; r < Rules::kCategoryStrength.size(); ++r) {
+        if (Rules::kCategoryStrength[r] == strength) {
+            result.rank = static_cast<HandRank>(r);
+            break;
+        }
+    }
+
+    uint8_t count = kTiebreakerCount[static_cast<uint8_t>(result.rank)];
+    for (uint8_t i = 0; i < count; ++i) {
+        result.tiebreakers.push_back(static_cast<uint8_t>((score >> (16 - 4 * i)) & 0xF));
+    }
+    return result;
+}
+
+template <typename Rules>
+std::vector<Card> VariantEvaluator<Rules>::deck() {
+    std::vector<Card> cards;
+    cards.reserve(4 * (15 - kMinRank));
+
+    for (int s = 0; s < 4; ++s) {
+        for (int r = kMinRank; r <= 14; ++r) {
+            cards.emplace_back(static_cast<Rank>(r), static_cast<Suit>(s));
+        }
+    }
+    return cards;
+}
+
+} // namespace poker
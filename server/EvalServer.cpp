@@ -0,0 +1,477 @@
+#include "EvalServer.h"
+#include "../game/BatchEvaluator.h"
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace poker {
+
+namespace {
+
+constexpr size_t READ_CHUNK = 64 * 1024;
+
+// Stop reading from a client whose unsent responses pass this size
+constexpr size_t MAX_PENDING_OUT = 1 << 20;
+
+bool writeAll(int fd, const std::vector<uint8_t>& data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t n = write(fd, data.data() + written, data.size() - written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Send as much of out as the socket takes without blocking and drop the sent
+// prefix. False if the peer is gone.
+bool flush(int fd, std::vector<uint8_t>& out) {
+    size_t written = 0;
+    while (written < out.size()) {
+        ssize_t n = send(fd, out.data() + written, out.size() - written, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+    out.erase(out.begin(), out.begin() + written);
+    return true;
+}
+
+void fillEquity(const Request& request, Response& response) {
+    EquityResult equity = BatchEvaluator::equity(
+        request.cards, request.cards + 2, request.cards + 4, request.cardCount - 4);
+    response.payloadSize = 12;
+    Protocol::writeU32(response.payload, equity.wins);
+    Protocol::writeU32(response.payload + 4, equity.ties);
+    Protocol::writeU32(response.payload + 8, equity.losses);
+}
+
+// Worker threads enumerating equity off the poll loop. Each finished job is
+// queued for the loop and a byte on the wake pipe makes poll return.
+class EquityPool {
+public:
+    struct Job {
+        uint64_t client;
+        Request request;
+        Response response;
+    };
+
+    explicit EquityPool(unsigned threads) {
+        if (pipe(wake_) != 0) {
+            throw std::runtime_error(std::string("pipe: ") + std::strerror(errno));
+        }
+        fcntl(wake_[0], F_SETFL, O_NONBLOCK);
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned i = 0; i < threads; ++i) {
+            workers_.emplace_back([this]() { work(); });
+        }
+    }
+
+    ~EquityPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        ready_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+        close(wake_[0]);
+        close(wake_[1]);
+    }
+
+    int wakeFd() const { return wake_[0]; }
+
+    void submit(uint64_t client, const Request& request, const Response& response) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queued_.push_back({client, request, response});
+        }
+        ready_.notify_one();
+    }
+
+    // Finished jobs since the last call
+    std::vector<Job> drain() {
+        uint8_t bytes[64];
+        while (read(wake_[0], bytes, sizeof(bytes)) > 0) {
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<Job> done(finished_.begin(), finished_.end());
+        finished_.clear();
+        return done;
+    }
+
+private:
+    void work() {
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ready_.wait(lock, [this]() { return stopping_ || !queued_.empty(); });
+                if (stopping_) return;
+                job = queued_.front();
+                queued_.pop_front();
+            }
+            fillEquity(job.request, job.response);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                finished_.push_back(job);
+            }
+            uint8_t byte = 1;
+            ssize_t ignored = write(wake_[1], &byte, 1);
+            (void)ignored;
+        }
+    }
+
+    int wake_[2];
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<Job> queued_;
+    std::deque<Job> finished_;
+    bool stopping_ = false;
+};
+
+// Decode every complete frame at the front of buffer, then drop those bytes
+void takeFrames(std::vector<uint8_t>& buffer, std::vector<Request>& requests) {
+    size_t offset = 0;
+    Request request;
+    while (size_t used = Protocol::decodeRequest(buffer.data() + offset,
+                                                 buffer.size() - offset, request)) {
+        requests.push_back(request);
+        offset += used;
+    }
+    buffer.erase(buffer.begin(), buffer.begin() + offset);
+}
+
+} // namespace
+
+EvalServer::EvalServer(size_t cacheEntries, unsigned equityThreads)
+    : cache_(cacheEntries), equityThreads_(equityThreads), running_(false) {}
+
+bool EvalServer::validate(const Request& request) {
+    size_t minCards = 0;
+    size_t maxCards = 0;
+    switch (request.op) {
+        case Op::EVALUATE: minCards = 5; maxCards = 7; break;
+        case Op::COMPARE:  minCards = 9; maxCards = 9; break;
+        case Op::EQUITY:   minCards = 4; maxCards = 9; break;
+        default: return false;
+    }
+    if (request.cardCount < minCards || request.cardCount > maxCards) {
+        return false;
+    }
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < request.cardCount; ++i) {
+        uint8_t card = request.cards[i];
+        if (card >= 52 || (seen & (uint64_t(1) << card))) return false;
+        seen |= uint64_t(1) << card;
+    }
+    return true;
+}
+
+void EvalServer::answerBatch(const std::vector<Request>& requests,
+                             std::vector<Response>& responses,
+                             std::vector<size_t>* deferred) {
+    responses.resize(requests.size());
+
+    // Evaluate and compare misses are scored together in one batch; each
+    // compare contributes two hands
+    std::vector<HandCards> hands;
+    std::vector<size_t> owners;
+
+    for (size_t i = 0; i < requests.size(); ++i) {
+        const Request& request = requests[i];
+        Response& response = responses[i];
+        response.id = request.id;
+        response.status = Status::OK;
+        response.payloadSize = 0;
+        ++stats_.requests;
+
+        if (!validate(request)) {
+            response.status = Status::BAD_REQUEST;
+            continue;
+        }
+        if (cache_.lookup(request, response)) {
+            ++stats_.cacheHits;
+            continue;
+        }
+
+        if (request.op == Op::EVALUATE) {
+            HandCards hand;
+            std::memcpy(hand.cards, request.cards, request.cardCount);
+            hand.count = request.cardCount;
+            hands.push_back(hand);
+            owners.push_back(i);
+        } else if (request.op == Op::COMPARE) {
+            for (size_t player = 0; player < 2; ++player) {
+                HandCards hand;
+                hand.cards[0] = request.cards[2 * player];
+                hand.cards[1] = request.cards[2 * player + 1];
+                std::memcpy(hand.cards + 2, request.cards + 4, 5);
+                hand.count = 7;
+                hands.push_back(hand);
+                owners.push_back(i);
+            }
+        } else if (deferred) {
+            deferred->push_back(i);
+        } else {
+            fillEquity(request, response);
+            cache_.insert(request, response);
+        }
+    }
+
+    if (hands.empty()) return;
+
+    std::vector<uint32_t> scores(hands.size());
+    BatchEvaluator::scoreBatch(hands.data(), hands.size(), scores.data());
+    ++stats_.batches;
+
+    for (size_t h = 0; h < hands.size(); ++h) {
+        size_t i = owners[h];
+        Response& response = responses[i];
+        if (requests[i].op == Op::EVALUATE) {
+            response.payloadSize = 4;
+            Protocol::writeU32(response.payload, scores[h]);
+        } else {
+            uint32_t score1 = scores[h];
+            uint32_t score2 = scores[++h];
+            CompareResult result = score1 > score2   ? CompareResult::HAND1_WINS
+                                   : score1 < score2 ? CompareResult::HAND2_WINS
+                                                     : CompareResult::TIE;
+            response.payloadSize = 1;
+            response.payload[0] = static_cast<uint8_t>(static_cast<int8_t>(result));
+        }
+        cache_.insert(requests[i], response);
+    }
+}
+
+size_t EvalServer::process(const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+    std::vector<Request> requests;
+    size_t offset = 0;
+    Request request;
+    while (size_t used = Protocol::decodeRequest(data + offset, size - offset, request)) {
+        requests.push_back(request);
+        offset += used;
+    }
+
+    std::vector<Response> responses;
+    answerBatch(requests, responses);
+    for (const auto& response : responses) {
+        Protocol::encodeResponse(response, out);
+    }
+    return offset;
+}
+
+void EvalServer::serveStream(int inFd, int outFd) {
+    std::vector<uint8_t> in;
+    std::vector<uint8_t> out;
+    std::vector<uint8_t> chunk(READ_CHUNK);
+    EquityPool pool(equityThreads_);
+    size_t pending = 0;
+    bool eof = false;
+
+    // After EOF on inFd, keep going until the pool has answered everything
+    while (!eof || pending > 0) {
+        pollfd fds[2] = {{pool.wakeFd(), POLLIN, 0}, {inFd, POLLIN, 0}};
+        int ready = poll(fds, eof ? 1 : 2, -1);
+        if (ready < 0 && errno == EINTR) continue;
+        if (ready < 0) break;
+
+        if (fds[0].revents & POLLIN) {
+            for (const auto& job : pool.drain()) {
+                cache_.insert(job.request, job.response);
+                Protocol::encodeResponse(job.response, out);
+                --pending;
+            }
+        }
+
+        if (!eof && (fds[1].revents & (POLLIN | POLLHUP | POLLERR))) {
+            ssize_t n = read(inFd, chunk.data(), chunk.size());
+            if (n == 0 || (n < 0 && errno != EINTR)) {
+                eof = true;
+            } else if (n > 0) {
+                // Whatever has arrived since the last read is answered as one
+                // batch; equity goes to the pool and is answered when done
+                in.insert(in.end(), chunk.begin(), chunk.begin() + n);
+                std::vector<Request> requests;
+                takeFrames(in, requests);
+
+                std::vector<Response> responses;
+                std::vector<size_t> deferred;
+                answerBatch(requests, responses, &deferred);
+                for (size_t i = 0, d = 0; i < responses.size(); ++i) {
+                    if (d < deferred.size() && deferred[d] == i) {
+                        ++d;
+                        pool.submit(0, requests[i], responses[i]);
+                        ++pending;
+                    } else {
+                        Protocol::encodeResponse(responses[i], out);
+                    }
+                }
+            }
+        }
+
+        if (!writeAll(outFd, out)) break;
+        out.clear();
+    }
+}
+
+void EvalServer::serveUnixSocket(const std::string& path) {
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) {
+        throw std::invalid_argument("Socket path too long: " + path);
+    }
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, path.c_str());
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        throw std::runtime_error(std::string("socket: ") + std::strerror(errno));
+    }
+    unlink(path.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(listenFd, 64) < 0) {
+        int err = errno;
+        close(listenFd);
+        throw std::runtime_error("Cannot listen on " + path + ": " + std::strerror(err));
+    }
+
+    struct Client {
+        uint64_t id;
+        int fd;
+        std::vector<uint8_t> in;
+        std::vector<uint8_t> out;
+        size_t pending;       // Equity requests still on the pool
+        bool eof;             // Peer finished sending; close once answered
+        bool closed;
+    };
+    std::vector<Client> clients;
+    std::vector<uint8_t> chunk(READ_CHUNK);
+    uint64_t nextClientId = 0;
+    EquityPool pool(equityThreads_);
+
+    running_ = true;
+    while (running_) {
+        std::vector<pollfd> fds;
+        fds.push_back({listenFd, POLLIN, 0});
+        fds.push_back({pool.wakeFd(), POLLIN, 0});
+        for (const auto& client : clients) {
+            short events = 0;
+            if (!client.eof && client.out.size() < MAX_PENDING_OUT) events |= POLLIN;
+            if (!client.out.empty()) events |= POLLOUT;
+            fds.push_back({client.fd, events, 0});
+        }
+
+        int ready = poll(fds.data(), fds.size(), 100);
+        if (ready < 0 && errno == EINTR) continue;
+        if (ready < 0) break;
+        if (ready == 0) continue;
+
+        // Equity answers that finished since the last pass
+        if (fds[1].revents & POLLIN) {
+            for (const auto& job : pool.drain()) {
+                cache_.insert(job.request, job.response);
+                for (auto& client : clients) {
+                    if (client.id != job.client) continue;
+                    Protocol::encodeResponse(job.response, client.out);
+                    --client.pending;
+                    break;
+                }
+            }
+        }
+
+        // Gather every readable client's frames into a single batch
+        std::vector<Request> requests;
+        std::vector<size_t> owners;
+        for (size_t c = 0; c < clients.size(); ++c) {
+            if (!(fds[c + 2].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+
+            Client& client = clients[c];
+            if (client.eof) {
+                // Half-closed peers still get their answers; a full hang-up
+                // leaves nobody to read them
+                if (fds[c + 2].revents & (POLLHUP | POLLERR)) client.closed = true;
+                continue;
+            }
+            ssize_t n = read(client.fd, chunk.data(), chunk.size());
+            if (n < 0) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    client.closed = true;
+                }
+                continue;
+            }
+            if (n == 0) {
+                client.eof = true;
+                continue;
+            }
+            client.in.insert(client.in.end(), chunk.begin(), chunk.begin() + n);
+
+            size_t before = requests.size();
+            takeFrames(client.in, requests);
+            owners.insert(owners.end(), requests.size() - before, c);
+        }
+
+        std::vector<Response> responses;
+        std::vector<size_t> deferred;
+        answerBatch(requests, responses, &deferred);
+        for (size_t i = 0, d = 0; i < responses.size(); ++i) {
+            Client& client = clients[owners[i]];
+            if (d < deferred.size() && deferred[d] == i) {
+                ++d;
+                pool.submit(client.id, requests[i], responses[i]);
+                ++client.pending;
+            } else {
+                Protocol::encodeResponse(responses[i], client.out);
+            }
+        }
+
+        for (auto& client : clients) {
+            if (!client.closed && !client.out.empty() && !flush(client.fd, client.out)) {
+                client.closed = true;
+            }
+            if (client.eof && client.pending == 0 && client.out.empty()) client.closed = true;
+            if (client.closed) close(client.fd);
+        }
+        clients.erase(std::remove_if(clients.begin(), clients.end(),
+                                     [](const Client& client) { return client.closed; }),
+                      clients.end());
+
+        if (fds[0].revents & POLLIN) {
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd >= 0) {
+                fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+                clients.push_back({nextClientId++, fd, {}, {}, 0, false, false});
+            }
+        }
+    }
+
+    for (const auto& client : clients) {
+        close(client.fd);
+    }
+    close(listenFd);
+    unlink(path.c_str());
+}
+
+void EvalServer::stop() {
+    running_ = false;
+}
+
+} // namespace poker
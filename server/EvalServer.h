@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Protocol.h"
+#include "ResultCache.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace poker {
+
+struct ServerStats {
+    uint64_t requests = 0;
+    uint64_t batches = 0;      // Calls into the batch evaluator
+    uint64_t cacheHits = 0;
+};
+
+// Long-running evaluation daemon speaking the Protocol.h framing over a
+// stream (stdin/stdout) or a Unix domain socket. Every frame that has
+// arrived, across all clients, is answered as one batch: cached results are
+// served first and the remaining evaluations go to BatchEvaluator together.
+//
+// EQUITY enumerations (up to C(48,5) runouts) run on a worker pool in both
+// modes and are answered when they finish, so they never hold up other
+// requests. On the socket, client sockets are non-blocking and unsent
+// responses wait for POLLOUT. process() stays synchronous and answers
+// equity inline.
+class EvalServer {
+public:
+    // equityThreads: equity workers per serve call, 0 = one per core
+    explicit EvalServer(size_t cacheEntries = 1 << 16, unsigned equityThreads = 0);
+
+    // Answer every complete frame in data, appending responses to out.
+    // Returns bytes consumed; a trailing partial frame is left unconsumed.
+    size_t process(const uint8_t* data, size_t size, std::vector<uint8_t>& out);
+
+    // Serve one bidirectional stream until EOF on inFd and every pending
+    // equity answer is written
+    void serveStream(int inFd, int outFd);
+
+    // Listen on a Unix domain socket and serve clients until stop()
+    void serveUnixSocket(const std::string& path);
+
+    // Ask serveUnixSocket to return; safe to call from another thread
+    void stop();
+
+    const ServerStats& stats() const { return stats_; }
+
+private:
+    // Answer requests in place; responses[i] matches requests[i]. If
+    // deferred is set, uncached EQUITY requests are left unanswered and their
+    // indices appended to it instead.
+    void answerBatch(const std::vector<Request>& requests,
+                     std::vector<Response>& responses,
+                     std::vector<size_t>* deferred = nullptr);
+
+    static bool validate(const Request& request);
+
+    ResultCache cache_;
+    ServerStats stats_;
+    unsigned equityThreads_;
+    std::atomic<bool> running_;
+};
+
+} // namespace poker
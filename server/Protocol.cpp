@@ -0,0 +1,69 @@
+#include "Protocol.h"
+
+namespace poker {
+
+void Protocol::writeU32(uint8_t* out, uint32_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+    out[2] = static_cast<uint8_t>(value >> 16);
+    out[3] = static_cast<uint8_t>(value >> 24);
+}
+
+uint32_t Protocol::readU32(const uint8_t* in) {
+    return uint32_t(in[0]) | (uint32_t(in[1]) << 8) |
+           (uint32_t(in[2]) << 16) | (uint32_t(in[3]) << 24);
+}
+
+size_t Protocol::decodeRequest(const uint8_t* data, size_t size, Request& request) {
+    if (size < HEADER_SIZE) return 0;
+
+    uint8_t cardCount = data[5];
+    if (size < HEADER_SIZE + cardCount) return 0;
+
+    request.id = readU32(data);
+    request.op = static_cast<Op>(data[4]);
+    request.cardCount = cardCount;
+    for (size_t i = 0; i < cardCount && i < MAX_CARDS; ++i) {
+        request.cards[i] = data[HEADER_SIZE + i];
+    }
+    return HEADER_SIZE + cardCount;
+}
+
+size_t Protocol::decodeResponse(const uint8_t* data, size_t size, Response& response) {
+    if (size < HEADER_SIZE) return 0;
+
+    uint8_t payloadSize = data[5];
+    if (size < HEADER_SIZE + payloadSize) return 0;
+
+    response.id = readU32(data);
+    response.status = static_cast<Status>(data[4]);
+    response.payloadSize = payloadSize;
+    for (size_t i = 0; i < payloadSize && i < sizeof(response.payload); ++i) {
+        response.payload[i] = data[HEADER_SIZE + i];
+    }
+    return HEADER_SIZE + payloadSize;
+}
+
+void Protocol::encodeRequest(const Request& request, std::vector<uint8_t>& out) {
+    size_t start = out.size();
+    out.resize(start + HEADER_SIZE + request.cardCount);
+    writeU32(&out[start], request.id);
+    out[start + 4] = static_cast<uint8_t>(request.op);
+    out[start + 5] = request.cardCount;
+    for (size_t i = 0; i < request.cardCount; ++i) {
+        out[start + HEADER_SIZE + i] = request.cards[i];
+    }
+}
+
+void Protocol::encodeResponse(const Response& response, std::vector<uint8_t>& out) {
+    size_t start = out.size();
+    out.resize(start + HEADER_SIZE + response.payloadSize);
+    writeU32(&out[start], response.id);
+    out[start + 4] = static_cast<uint8_t>(response.status);
+    out[start + 5] = response.payloadSize;
+    for (size_t i = 0; i < response.payloadSize; ++i) {
+        out[start + HEADER_SIZE + i] = response.payload[i];
+    }
+}
+
+} // namespace poker
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace poker {
+
+// Binary protocol spoken by the evaluation server. Clients may pipeline any
+// number of requests; responses carry the request id and may be matched out
+// of order. Integers are little-endian, cards are Card::getIndex values.
+//
+//   Request:  u32 id | u8 op     | u8 cardCount   | cardCount cards
+//   Response: u32 id | u8 status | u8 payloadSize | payload
+//
+//   EVALUATE  5-7 cards             -> u32 packed HoldemEvaluator score
+//   COMPARE   hole1, hole2, board   -> i8 CompareResult (2 + 2 + 5 cards)
+//   EQUITY    hole1, hole2, board   -> u32 wins | u32 ties | u32 losses
+//                                      (2 + 2 + 0-5 cards, exhaustive)
+enum class Op : uint8_t {
+    EVALUATE = 1,
+    COMPARE = 2,
+    EQUITY = 3
+};
+
+enum class Status : uint8_t {
+    OK = 0,
+    BAD_REQUEST = 1
+};
+
+struct Request {
+    uint32_t id;
+    Op op;
+    uint8_t cardCount;
+    uint8_t cards[9];
+};
+
+struct Response {
+    uint32_t id;
+    Status status;
+    uint8_t payloadSize;
+    uint8_t payload[12];
+};
+
+class Protocol {
+public:
+    static constexpr size_t HEADER_SIZE = 6;
+    static constexpr size_t MAX_CARDS = 9;
+
+    // Decode one frame from data. Returns bytes consumed, or 0 if the frame is
+    // incomplete. Oversized card lists are consumed and flagged by cardCount.
+    static size_t decodeRequest(const uint8_t* data, size_t size, Request& request);
+    static size_t decodeResponse(const uint8_t* data, size_t size, Response& response);
+
+    // Append one frame to out
+    static void encodeRequest(const Request& request, std::vector<uint8_t>& out);
+    static void encodeResponse(const Response& response, std::vector<uint8_t>& out);
+
+    // Little-endian payload helpers
+    static void writeU32(uint8_t* out, uint32_t value);
+    static uint32_t readU32(const uint8_t* in);
+};
+
+} // namespace poker
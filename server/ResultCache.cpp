@@ -0,0 +1,76 @@
+#include "ResultCache.h"
+
+namespace poker {
+
+namespace {
+
+uint64_t maskOf(const uint8_t* cards, size_t count) {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < count; ++i) {
+        mask |= uint64_t(1) << cards[i];
+    }
+    return mask;
+}
+
+} // namespace
+
+bool ResultCache::Key::operator==(const Key& other) const {
+    return words[0] == other.words[0] && words[1] == other.words[1] &&
+           words[2] == other.words[2];
+}
+
+ResultCache::ResultCache(size_t entries) {
+    size_t size = 1;
+    while (size < entries) size <<= 1;
+    entries_.resize(size);
+}
+
+ResultCache::Key ResultCache::makeKey(const Request& request) {
+    // Card masks occupy the low 52 bits; the op tags the first word
+    Key key{};
+    if (request.op == Op::EVALUATE) {
+        key.words[0] = maskOf(request.cards, request.cardCount);
+    } else {
+        key.words[0] = maskOf(request.cards, 2);
+        key.words[1] = maskOf(request.cards + 2, 2);
+        key.words[2] = maskOf(request.cards + 4, request.cardCount - 4);
+    }
+    key.words[0] |= uint64_t(request.op) << 56;
+    return key;
+}
+
+size_t ResultCache::slot(const Key& key) const {
+    uint64_t h = key.words[0] * 0x9E3779B97F4A7C15ull;
+    h ^= (key.words[1] + (h >> 29)) * 0xBF58476D1CE4E5B9ull;
+    h ^= (key.words[2] + (h >> 31)) * 0x94D049BB133111EBull;
+    return static_cast<size_t>(h >> 32) & (entries_.size() - 1);
+}
+
+bool ResultCache::lookup(const Request& request, Response& response) const {
+    Key key = makeKey(request);
+    const Entry& entry = entries_[slot(key)];
+    if (!entry.valid || !(entry.key == key)) {
+        return false;
+    }
+
+    response.id = request.id;
+    response.status = Status::OK;
+    response.payloadSize = entry.payloadSize;
+    for (size_t i = 0; i < entry.payloadSize; ++i) {
+        response.payload[i] = entry.payload[i];
+    }
+    return true;
+}
+
+void ResultCache::insert(const Request& request, const Response& response) {
+    Key key = makeKey(request);
+    Entry& entry = entries_[slot(key)];
+    entry.key = key;
+    entry.valid = true;
+    entry.payloadSize = response.payloadSize;
+    for (size_t i = 0; i < response.payloadSize; ++i) {
+        entry.payload[i] = response.payload[i];
+    }
+}
+
+} // namespace poker
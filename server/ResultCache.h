@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Protocol.h"
+#include <cstdint>
+#include <vector>
+
+namespace poker {
+
+// Direct-mapped cache of answered requests shared by every client of a
+// server. Keys are card masks, so card order within a hand or board does not
+// matter. A colliding insert simply replaces the older entry.
+class ResultCache {
+public:
+    // Entry count is rounded up to a power of two
+    explicit ResultCache(size_t entries);
+
+    // Copy a cached payload into response; false on a miss
+    bool lookup(const Request& request, Response& response) const;
+    void insert(const Request& request, const Response& response);
+
+private:
+    struct Key {
+        uint64_t words[3];
+        bool operator==(const Key& other) const;
+    };
+
+    struct Entry {
+        Key key;
+        bool valid;
+        uint8_t payloadSize;
+        uint8_t payload[12];
+    };
+
+    static Key makeKey(const Request& request);
+    size_t slot(const Key& key) const;
+
+    std::vector<Entry> entries_;
+};
+
+} // namespace poker
@@ -0,0 +1,73 @@
+#include "EvalServer.h"
+#include <cctype>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <unistd.h>
+
+using namespace poker;
+
+namespace {
+
+// Whole non-negative decimal number, or false
+bool parseCount(const char* text, unsigned long& value) {
+    if (!std::isdigit(static_cast<unsigned char>(*text))) return false;
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtoul(text, &end, 10);
+    return errno == 0 && *end == '\0';
+}
+
+} // namespace
+
+// Usage: ninja_eval_server [--socket PATH] [--cache ENTRIES] [--equity-threads N]
+// Without --socket the server speaks the protocol over stdin/stdout.
+// --equity-threads sizes the equity pool; 0 (default) = one per core.
+int main(int argc, char** argv) {
+    std::string socketPath;
+    unsigned long cacheEntries = 1 << 16;
+    unsigned long equityThreads = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        bool ok = i + 1 < argc;
+        if (ok && std::strcmp(argv[i], "--socket") == 0) {
+            socketPath = argv[++i];
+        } else if (ok && std::strcmp(argv[i], "--cache") == 0) {
+            ok = parseCount(argv[++i], cacheEntries) && cacheEntries > 0 &&
+                 cacheEntries <= (1ul << 28);
+        } else if (ok && std::strcmp(argv[i], "--equity-threads") == 0) {
+            ok = parseCount(argv[++i], equityThreads) && equityThreads <= 1024;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--socket PATH] [--cache ENTRIES] [--equity-threads N]\n";
+            return 1;
+        }
+    }
+
+    // A client hanging up mid-write must not kill the daemon
+    std::signal(SIGPIPE, SIG_IGN);
+
+    static EvalServer server(cacheEntries, static_cast<unsigned>(equityThreads));
+    try {
+        if (socketPath.empty()) {
+            server.serveStream(STDIN_FILENO, STDOUT_FILENO);
+        } else {
+            std::signal(SIGINT, [](int) { server.stop(); });
+            std::signal(SIGTERM, [](int) { server.stop(); });
+            server.serveUnixSocket(socketPath);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    const ServerStats& stats = server.stats();
+    std::cerr << "requests=" << stats.requests << " batches=" << stats.batches
+              << " cacheHits=" << stats.cacheHits << "\n";
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include "../game/BatchEvaluator.h"
+#include "../game/VariantEvaluation.h"
+#include "../game/Card.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using namespace poker;
+
+// Helper to create card indices from string like "As Kh Qd Jc Ts"
+std::vector<uint8_t> makeIndices(const std::string &str)
+{
+    std::vector<uint8_t> cards;
+    size_t i = 0;
+    while (i < str.length())
+    {
+        if (str[i] == ' ')
+        {
+            ++i;
+            continue;
+        }
+        cards.push_back(Card::fromString(str.substr(i, 2)).getIndex());
+        i += 2;
+    }
+    return cards;
+}
+
+void testScoreMatchesEvaluator()
+{
+    auto cards = makeIndices("As Ah Ad Kc Ks 2d 3h");
+    uint32_t score = BatchEvaluator::score(cards.data(), cards.size());
+    assert(HoldemEvaluator::toHandResult(score).rank == HandRank::FULL_HOUSE);
+
+    HandCards hands[2] = {};
+    auto flush = makeIndices("As Ks Qs Js 9s");
+    auto straight = makeIndices("As Kd Qh Jc Ts");
+    std::copy(flush.begin(), flush.end(), hands[0].cards);
+    std::copy(straight.begin(), straight.end(), hands[1].cards);
+    hands[0].count = hands[1].count = 5;
+
+    uint32_t scores[2];
+    BatchEvaluator::scoreBatch(hands, 2, scores);
+    assert(scores[0] > scores[1]);
+    std::cout << "✓ Batch scores match evaluator\n";
+}
+
+void testCompare()
+{
+    auto aces = makeIndices("As Ah");
+    auto kings = makeIndices("Ks Kh");
+    auto board = makeIndices("2d 5c 8h Jd Qc");
+    assert(BatchEvaluator::compare(aces.data(), kings.data(), board.data()) ==
+           CompareResult::HAND1_WINS);
+    assert(BatchEvaluator::compare(kings.data(), aces.data(), board.data()) ==
+           CompareResult::HAND2_WINS);
+    std::cout << "✓ Compare\n";
+}
+
+void testEquity()
+{
+    // Set over set on the turn: kings need the last king, 1 out of 44
+    auto aces = makeIndices("As Ah");
+    auto kings = makeIndices("Ks Kh");
+    auto board = makeIndices("Ad Kd 7c 2s");
+    auto result = BatchEvaluator::equity(aces.data(), kings.data(), board.data(), board.size());
+    assert(result.wins + result.ties + result.losses == 44);
+    assert(result.losses == 1);
+
+    // Flop: 990 runouts
+    board.pop_back();
+    result = BatchEvaluator::equity(aces.data(), kings.data(), board.data(), board.size());
+    assert(result.wins + result.ties + result.losses == 990);
+    assert(result.equity() > 0.9);
+
+    bool threw = false;
+    try
+    {
+        BatchEvaluator::equity(aces.data(), aces.data(), board.data(), board.size());
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "✓ Exhaustive equity\n";
+}
+
+template <typename F>
+bool throwsInvalid(F f)
+{
+    try
+    {
+        f();
+    }
+    catch (const std::invalid_argument &)
+    {
+        return true;
+    }
+    return false;
+}
+
+void testRejectsBadInput()
+{
+    uint32_t scores[2];
+    HandCards hands[2] = {{{0, 4, 8, 12, 17, 21, 25}, 7}, {{0, 4, 8, 12, 17, 21, 25}, 8}};
+    assert(throwsInvalid([&]()
+                         { BatchEvaluator::scoreBatch(hands, 2, scores); }));
+    hands[1].count = 5;
+    hands[1].cards[4] = 52;
+    assert(throwsInvalid([&]()
+                         { BatchEvaluator::scoreBatch(hands, 2, scores); }));
+    hands[1].cards[4] = 51;
+    BatchEvaluator::scoreBatch(hands, 2, scores);
+
+    auto aces = makeIndices("As Ah");
+    auto board = makeIndices("2d 5c 8h Jd Qc");
+    uint8_t bad[2] = {60, 1};
+    assert(throwsInvalid([&]()
+                         { BatchEvaluator::compare(aces.data(), bad, board.data()); }));
+    assert(throwsInvalid([&]()
+                         { BatchEvaluator::compare(aces.data(), aces.data(), board.data()); }));
+    assert(throwsInvalid([&]()
+                         { BatchEvaluator::score(bad, 2); }));
+    std::cout << "✓ Rejects bad input\n";
+}
+
+int main()
+{
+    std::cout << "Running BatchEvaluator tests...\n\n";
+
+    testScoreMatchesEvaluator();
+    testCompare();
+    testEquity();
+    testRejectsBadInput();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
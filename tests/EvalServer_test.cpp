@@ -0,0 +1,295 @@
+#include "../server/EvalServer.h"
+#include "../server/Protocol.h"
+#include "../game/Card.h"
+#include "../game/HandEvaluation.h"
+#include <iostream>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace poker;
+
+Request makeRequest(uint32_t id, Op op, const std::string &str)
+{
+    Request request{};
+    request.id = id;
+    request.op = op;
+    size_t i = 0;
+    while (i < str.length())
+    {
+        if (str[i] == ' ')
+        {
+            ++i;
+            continue;
+        }
+        request.cards[request.cardCount++] = Card::fromString(str.substr(i, 2)).getIndex();
+        i += 2;
+    }
+    return request;
+}
+
+std::vector<Response> decodeAll(const std::vector<uint8_t> &data)
+{
+    std::vector<Response> responses;
+    size_t offset = 0;
+    Response response;
+    while (size_t used = Protocol::decodeResponse(data.data() + offset, data.size() - offset, response))
+    {
+        responses.push_back(response);
+        offset += used;
+    }
+    assert(offset == data.size());
+    return responses;
+}
+
+void testRoundTrip()
+{
+    std::vector<uint8_t> frame;
+    Protocol::encodeRequest(makeRequest(0xDEADBEEF, Op::COMPARE, "As Ah Ks Kh 2d 5c 8h Jd Qc"), frame);
+    assert(frame.size() == Protocol::HEADER_SIZE + 9);
+
+    Request request;
+    assert(Protocol::decodeRequest(frame.data(), frame.size() - 1, request) == 0);
+    assert(Protocol::decodeRequest(frame.data(), frame.size(), request) == frame.size());
+    assert(request.id == 0xDEADBEEF);
+    assert(request.op == Op::COMPARE);
+    assert(request.cardCount == 9);
+    std::cout << "✓ Protocol round trip\n";
+}
+
+void testPipelinedBatch()
+{
+    EvalServer server;
+    std::vector<uint8_t> in;
+    Protocol::encodeRequest(makeRequest(1, Op::EVALUATE, "As Ah Ad Kc Ks 2d 3h"), in);
+    Protocol::encodeRequest(makeRequest(2, Op::COMPARE, "As Ah Ks Kh 2d 5c 8h Jd Qc"), in);
+    Protocol::encodeRequest(makeRequest(3, Op::EQUITY, "As Ah Ks Kh Ad Kd 7c 2s"), in);
+    Protocol::encodeRequest(makeRequest(4, Op::EVALUATE, "As Ah"), in);
+    Protocol::encodeRequest(makeRequest(5, Op::EVALUATE, "Ks Kc Ah Ad As 3h 2d"), in);
+    size_t complete = in.size();
+    Protocol::encodeRequest(makeRequest(6, Op::EVALUATE, "As Ah Ad Kc Ks"), in);
+
+    // The trailing frame is cut short and must be left for the next read
+    std::vector<uint8_t> out;
+    assert(server.process(in.data(), in.size() - 2, out) == complete);
+
+    auto responses = decodeAll(out);
+    assert(responses.size() == 5);
+    assert(responses[0].id == 1 && responses[0].status == Status::OK);
+    assert(responses[0].payloadSize == 4);
+    assert(responses[1].payload[0] == static_cast<uint8_t>(CompareResult::HAND1_WINS));
+    assert(Protocol::readU32(responses[2].payload + 8) == 1); // One losing river
+    assert(responses[3].status == Status::BAD_REQUEST);
+
+    assert(Protocol::readU32(responses[4].payload) == Protocol::readU32(responses[0].payload));
+
+    // Same cards in a different order hit the shared cache
+    std::vector<uint8_t> again;
+    Protocol::encodeRequest(makeRequest(7, Op::EVALUATE, "2d 3h As Ah Ad Kc Ks"), again);
+    out.clear();
+    server.process(again.data(), again.size(), out);
+    assert(decodeAll(out)[0].id == 7);
+    assert(server.stats().cacheHits == 1);
+    assert(server.stats().batches == 1);
+    std::cout << "✓ Pipelined batch with cache\n";
+}
+
+void testServeStream()
+{
+    int fds[2];
+    int paired = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    assert(paired == 0);
+
+    EvalServer server;
+    std::thread worker([&]()
+                       { server.serveStream(fds[1], fds[1]); close(fds[1]); });
+
+    std::vector<uint8_t> in;
+    for (uint32_t id = 0; id < 100; ++id)
+    {
+        Protocol::encodeRequest(makeRequest(id, Op::EVALUATE, "As Ah Ad Kc Ks 2d 3h"), in);
+    }
+    ssize_t written = write(fds[0], in.data(), in.size());
+    assert(written == ssize_t(in.size()));
+    shutdown(fds[0], SHUT_WR);
+
+    std::vector<uint8_t> out;
+    uint8_t buffer[4096];
+    ssize_t n;
+    while ((n = read(fds[0], buffer, sizeof(buffer))) > 0)
+    {
+        out.insert(out.end(), buffer, buffer + n);
+    }
+    worker.join();
+    close(fds[0]);
+
+    auto responses = decodeAll(out);
+    assert(responses.size() == 100);
+    for (uint32_t id = 0; id < 100; ++id)
+    {
+        assert(responses[id].id == id);
+    }
+    std::cout << "✓ Serve stream\n";
+}
+
+int connectTo(const std::string &path)
+{
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, path.c_str());
+    for (int attempt = 0; attempt < 200; ++attempt)
+    {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0)
+            return fd;
+        close(fd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    assert(false && "server never listened");
+    return -1;
+}
+
+void sendAll(int fd, const std::vector<uint8_t> &data)
+{
+    size_t sent = 0;
+    while (sent < data.size())
+    {
+        ssize_t n = write(fd, data.data() + sent, data.size() - sent);
+        assert(n > 0);
+        sent += static_cast<size_t>(n);
+    }
+}
+
+std::vector<Response> readResponses(int fd, size_t count)
+{
+    std::vector<uint8_t> data;
+    std::vector<Response> responses;
+    uint8_t buffer[65536];
+    size_t offset = 0;
+    while (responses.size() < count)
+    {
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        assert(n > 0);
+        data.insert(data.end(), buffer, buffer + n);
+        Response response;
+        while (size_t used = Protocol::decodeResponse(data.data() + offset, data.size() - offset, response))
+        {
+            responses.push_back(response);
+            offset += used;
+        }
+    }
+    return responses;
+}
+
+bool readable(int fd, int timeoutMs)
+{
+    pollfd pfd = {fd, POLLIN, 0};
+    return poll(&pfd, 1, timeoutMs) == 1;
+}
+
+void testServeStreamEquity()
+{
+    int fds[2];
+    int paired = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    assert(paired == 0);
+
+    EvalServer server(1 << 10, 1);
+    std::thread worker([&]()
+                       { server.serveStream(fds[1], fds[1]); close(fds[1]); });
+
+    // Preflop equity runs on the pool; the evaluate behind it is answered first
+    std::vector<uint8_t> frames;
+    Protocol::encodeRequest(makeRequest(1, Op::EQUITY, "As Ah Ks Kh"), frames);
+    Protocol::encodeRequest(makeRequest(2, Op::EVALUATE, "As Ah Ad Kc Ks 2d 3h"), frames);
+    sendAll(fds[0], frames);
+    assert(readResponses(fds[0], 1)[0].id == 2);
+
+    // EOF still waits for the pending equity answer
+    shutdown(fds[0], SHUT_WR);
+    auto equity = readResponses(fds[0], 1)[0];
+    worker.join();
+    close(fds[0]);
+
+    assert(equity.id == 1 && equity.payloadSize == 12);
+    uint32_t runouts = Protocol::readU32(equity.payload) + Protocol::readU32(equity.payload + 4) +
+                       Protocol::readU32(equity.payload + 8);
+    assert(runouts == 1712304); // C(48, 5)
+    std::cout << "✓ Serve stream answers equity off the read loop\n";
+}
+
+void testUnixSocketClients()
+{
+    const std::string path = "/tmp/ninja_eval_server_test.sock";
+    EvalServer server(1 << 10, 1);
+    std::thread worker([&]()
+                       { server.serveUnixSocket(path); });
+
+    // A preflop equity request (C(48,5) runouts) goes to the worker pool...
+    int slow = connectTo(path);
+    std::vector<uint8_t> frames;
+    Protocol::encodeRequest(makeRequest(1, Op::EQUITY, "As Ah Ks Kh"), frames);
+    sendAll(slow, frames);
+
+    // ...so another client is answered while it runs
+    int fast = connectTo(path);
+    frames.clear();
+    Protocol::encodeRequest(makeRequest(2, Op::EVALUATE, "As Ah Ad Kc Ks 2d 3h"), frames);
+    sendAll(fast, frames);
+    assert(readResponses(fast, 1)[0].id == 2);
+    assert(!readable(slow, 0));
+
+    // A client that pipelines without reading must not stall the others
+    const uint32_t flood = 300000;
+    int greedy = connectTo(path);
+    std::thread writer([&]()
+                       {
+        std::vector<uint8_t> requests;
+        for (uint32_t id = 0; id < flood; ++id)
+            Protocol::encodeRequest(makeRequest(id, Op::EVALUATE, "As Ah Ad Kc Ks 2d 3h"), requests);
+        sendAll(greedy, requests); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    frames.clear();
+    Protocol::encodeRequest(makeRequest(3, Op::COMPARE, "As Ah Ks Kh 2d 5c 8h Jd Qc"), frames);
+    sendAll(fast, frames);
+    assert(readable(fast, 5000));
+    assert(readResponses(fast, 1)[0].id == 3);
+
+    auto flooded = readResponses(greedy, flood);
+    writer.join();
+    for (uint32_t id = 0; id < flood; ++id)
+        assert(flooded[id].id == id);
+
+    auto equity = readResponses(slow, 1)[0];
+    assert(equity.id == 1 && equity.payloadSize == 12);
+    uint32_t runouts = Protocol::readU32(equity.payload) + Protocol::readU32(equity.payload + 4) +
+                       Protocol::readU32(equity.payload + 8);
+    assert(runouts == 1712304); // C(48, 5)
+
+    close(slow);
+    close(fast);
+    close(greedy);
+    server.stop();
+    worker.join();
+    std::cout << "✓ Unix socket clients do not block each other\n";
+}
+
+int main()
+{
+    std::cout << "Running EvalServer tests...\n\n";
+
+    testRoundTrip();
+    testPipelinedBatch();
+    testServeStream();
+    testServeStreamEquity();
+    testUnixSocketClients();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -2,6 +2,7 @@
 #include "../game/Card.h"
 #include <iostream>
 #include <cassert>
+#include <stdexcept>
 #include <string>
 
 using namespace poker;
@@ -177,6 +178,56 @@ void testKickerMatters()
     std::cout << "✓ Kicker matters\n";
 }
 
+void testSevenCardTiebreakers()
+{
+    // Third pair can play as the two-pair kicker
+    auto result = HandEvaluator::evaluate(makeHand("Ks Kh 9d 9c 4s 4h 2d"));
+    assert(result.rank == HandRank::TWO_PAIR);
+    assert((result.tiebreakers == Tiebreakers{13, 9, 4}));
+
+    // Two sets: the lower one fills the house
+    result = HandEvaluator::evaluate(makeHand("7s 7h 7d 5c 5s 5h Ad"));
+    assert(result.rank == HandRank::FULL_HOUSE);
+    assert((result.tiebreakers == Tiebreakers{7, 5}));
+
+    // Six-card run: the higher straight counts
+    result = HandEvaluator::evaluate(makeHand("Ad 2c 3h 4s 5d 6c Kh"));
+    assert(result.rank == HandRank::STRAIGHT);
+    assert((result.tiebreakers == Tiebreakers{6}));
+
+    // Six suited cards: the five highest count
+    result = HandEvaluator::evaluate(makeHand("Ah Th 8h 6h 4h 2h 9c"));
+    assert(result.rank == HandRank::FLUSH);
+    assert((result.tiebreakers == Tiebreakers{14, 10, 8, 6, 4}));
+
+    // Straight flush and a higher plain straight
+    result = HandEvaluator::evaluate(makeHand("5h 6h 7h 8h 9h Tc Jd"));
+    assert(result.rank == HandRank::STRAIGHT_FLUSH);
+    assert((result.tiebreakers == Tiebreakers{9}));
+    std::cout << "✓ Seven card tiebreakers\n";
+}
+
+void testHoleAndCommunity()
+{
+    auto hole = makeHand("Qs Jd");
+    auto community = makeHand("Ts 9h 8c 2d 2s");
+    auto all = hole;
+    all.insert(all.end(), community.begin(), community.end());
+    assert(HandEvaluator::evaluate(hole, community) == HandEvaluator::evaluate(all));
+
+    bool threw = false;
+    try
+    {
+        HandEvaluator::evaluate(hole, makeHand("Ts 9h"));
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    assert(threw);
+    std::cout << "✓ Hole and community cards\n";
+}
+
 int main()
 {
     std::cout << "Running HandEvaluator tests...\n\n";
@@ -197,6 +248,8 @@ int main()
     testCompareTie();
     testFlushBeatsStaight();
     testKickerMatters();
+    testSevenCardTiebreakers();
+    testHoleAndCommunity();
 
     std::cout << "\nAll tests passed!\n";
     return 0;
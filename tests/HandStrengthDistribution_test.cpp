@@ -0,0 +1,228 @@
+#include "../game/HandStrengthDistribution.h"
+#include "../game/VariantEvaluation.h"
+#include "../game/Range.h"
+#include "../game/Card.h"
+#include <iostream>
+#include <cassert>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace poker;
+
+// Helper to create cards from string like "As Kh Qd Jc Ts"
+std::vector<Card> makeHand(const std::string &str)
+{
+    std::vector<Card> cards;
+    size_t i = 0;
+    while (i < str.length())
+    {
+        if (str[i] == ' ')
+        {
+            ++i;
+            continue;
+        }
+        cards.push_back(Card::fromString(str.substr(i, 2)));
+        i += 2;
+    }
+    return cards;
+}
+
+struct Collected
+{
+    std::vector<uint8_t> boardSizes;
+    std::vector<uint8_t> cards;
+    std::vector<std::vector<uint16_t>> counts;
+};
+
+Collected collect(const HandStrengthDistribution &dist, unsigned threads)
+{
+    Collected out;
+    size_t values = dist.combos().size() * dist.bins();
+    dist.compute([&](const DistributionRecord &record)
+                 {
+        out.boardSizes.push_back(record.boardSize);
+        out.cards.push_back(record.card);
+        out.counts.emplace_back(record.counts, record.counts + values); },
+                 threads);
+    return out;
+}
+
+void testTurnMatchesBruteForce()
+{
+    auto board = makeHand("Ah 7d 6s 2c");
+    auto hands = Range::parse("AA, KK, 76s, 98s");
+    auto opponents = Range::parse("22+, A2s+, KTo+");
+    const size_t bins = 10;
+
+    HandStrengthDistribution dist(board, hands, opponents, bins);
+    auto result = collect(dist, 2);
+    assert(result.counts.size() == 1);
+    assert(result.boardSizes[0] == 4);
+
+    std::vector<uint16_t> expected(dist.combos().size() * bins);
+    uint64_t dead = Range::cardMask(board);
+    for (uint8_t river = 0; river < 52; ++river)
+    {
+        if (dead & (uint64_t(1) << river))
+            continue;
+        auto full = board;
+        full.push_back(Card::fromIndex(river));
+        uint64_t fullDead = dead | (uint64_t(1) << river);
+
+        for (size_t slot = 0; slot < dist.combos().size(); ++slot)
+        {
+            auto [hi, lo] = Range::comboCards(dist.combos()[slot]);
+            uint64_t handMask = (uint64_t(1) << hi) | (uint64_t(1) << lo);
+            if (fullDead & handMask)
+                continue;
+            uint32_t hero = HoldemEvaluator::score({Card::fromIndex(hi), Card::fromIndex(lo)}, full);
+
+            float wins = 0.0f, ties = 0.0f, seen = 0.0f;
+            for (size_t combo = 0; combo < Range::NUM_COMBOS; ++combo)
+            {
+                auto [ohi, olo] = Range::comboCards(combo);
+                uint64_t oppMask = (uint64_t(1) << ohi) | (uint64_t(1) << olo);
+                if (opponents[combo] == 0.0f || (oppMask & (fullDead | handMask)))
+                    continue;
+                uint32_t villain = HoldemEvaluator::score({Card::fromIndex(ohi), Card::fromIndex(olo)}, full);
+                seen += 1.0f;
+                if (hero > villain)
+                    wins += 1.0f;
+                else if (hero == villain)
+                    ties += 1.0f;
+            }
+            float strength = (wins + 0.5f * ties) / seen;
+            size_t bin = std::min(static_cast<size_t>(strength * bins), bins - 1);
+            ++expected[slot * bins + bin];
+        }
+    }
+    assert(result.counts[0] == expected);
+    std::cout << "✓ Turn distribution matches brute force\n";
+}
+
+void testFlopRollup()
+{
+    auto board = makeHand("Ks 9h 4d");
+    auto hands = Range::parse("KQs, 99, JTs");
+    auto opponents = Range::parse("77+, AJs+, KQo");
+    const size_t bins = 8;
+
+    HandStrengthDistribution dist(board, hands, opponents, bins);
+    auto single = collect(dist, 1);
+    auto parallel = collect(dist, 4);
+    assert(single.counts == parallel.counts);
+
+    // 49 turn histograms, then the flop
+    assert(single.counts.size() == 50);
+    assert(single.boardSizes.back() == 3);
+    assert(single.cards.back() == HandStrengthDistribution::NO_CARD);
+
+    size_t values = dist.combos().size() * bins;
+    std::vector<uint32_t> rolled(values);
+    for (size_t t = 0; t < 49; ++t)
+    {
+        assert(single.boardSizes[t] == 4);
+        for (size_t i = 0; i < values; ++i)
+            rolled[i] += single.counts[t][i];
+    }
+    for (size_t slot = 0; slot < dist.combos().size(); ++slot)
+    {
+        uint32_t runouts = 0;
+        for (size_t b = 0; b < bins; ++b)
+        {
+            assert(rolled[slot * bins + b] == single.counts.back()[slot * bins + b]);
+            runouts += single.counts.back()[slot * bins + b];
+        }
+        // Each unordered (turn, river) pair counted once per turn order
+        assert(runouts == 2 * 1081);
+    }
+    std::cout << "✓ Flop rollup of turn histograms\n";
+}
+
+void testStreamFormat()
+{
+    auto board = makeHand("Ah 7d 6s 2c");
+    HandStrengthDistribution dist(board, Range::parse("AA"), Range::parse("KK+"), 4);
+
+    std::ostringstream out;
+    dist.write(out, 1);
+    std::string data = out.str();
+
+    size_t slots = dist.combos().size();
+    assert(slots == 3);
+    size_t header = 4 + 1 + 4 + 2 + 2 + 2 * slots;
+    assert(data.size() == header + 2 + 2 * slots * 4);
+    assert(data.compare(0, 4, "HSD1") == 0);
+    assert(data[4] == 4);
+    assert(data[header] == 4);
+    assert(static_cast<uint8_t>(data[header + 1]) == HandStrengthDistribution::NO_CARD);
+    std::cout << "✓ Streaming binary format\n";
+}
+
+void testBlockedFractionalWeights()
+{
+    // Every villain combo shares a card with the hero: the weight subtracted
+    // back out must leave the hand facing nothing, not a rounding residue
+    auto board = makeHand("2c 7d 9s Jh 4h");
+    Range hero;
+    hero.setWeight(Card::fromString("Ah"), Card::fromString("Kc"), 1.0f);
+    Range villain;
+    for (const char *hand : {"Ah Qs", "Ah Qd", "Ah Tc", "Ah Td", "Kc Qs", "Kc Qd", "Ah Kc"})
+    {
+        auto cards = makeHand(hand);
+        villain.setWeight(cards[0], cards[1], 0.1f);
+    }
+
+    HandStrengthDistribution dist({board.begin(), board.end() - 1}, hero, villain, 4);
+    uint8_t full[5];
+    for (size_t i = 0; i < 5; ++i)
+        full[i] = board[i].getIndex();
+
+    ShowdownShare share;
+    dist.riverShares(full, &share);
+    assert(share.seen == 0.0f);
+    float strength = 0.0f;
+    dist.riverStrengths(full, &strength);
+    assert(strength == -1.0f);
+    uint8_t bin = 0;
+    dist.riverBins(full, &bin);
+    assert(bin == HandStrengthDistribution::NO_CARD);
+    std::cout << "✓ Fully blocked hands with fractional weights\n";
+}
+
+void testSinkFailure()
+{
+    // A throwing sink stops the remaining turns and surfaces on the caller
+    auto board = makeHand("Ks 9h 4d");
+    HandStrengthDistribution dist(board, Range::parse("KQs"), Range::parse("77+"), 4);
+    size_t calls = 0;
+    bool thrown = false;
+    try
+    {
+        dist.compute([&](const DistributionRecord &) {
+            if (++calls == 2)
+                throw std::runtime_error("sink full");
+        }, 4);
+    }
+    catch (const std::runtime_error &)
+    {
+        thrown = true;
+    }
+    assert(thrown && calls == 2);
+    std::cout << "✓ Sink failure stops compute\n";
+}
+
+int main()
+{
+    std::cout << "Running HandStrengthDistribution tests...\n\n";
+
+    testTurnMatchesBruteForce();
+    testFlopRollup();
+    testStreamFormat();
+    testBlockedFractionalWeights();
+    testSinkFailure();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,213 @@
+#include "../game/OutsAnalyzer.h"
+#include "../game/BatchEvaluator.h"
+#include "../game/HandEvaluation.h"
+#include "../game/Deck.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <string>
+
+using namespace poker;
+
+// Helper to create cards from string like "As Kh Qd Jc Ts"
+std::vector<Card> makeHand(const std::string &str)
+{
+    std::vector<Card> cards;
+    size_t i = 0;
+    while (i < str.length())
+    {
+        if (str[i] == ' ')
+        {
+            ++i;
+            continue;
+        }
+        cards.push_back(Card::fromString(str.substr(i, 2)));
+        i += 2;
+    }
+    return cards;
+}
+
+uint64_t maskOf(const std::string &str)
+{
+    return Range::cardMask(makeHand(str));
+}
+
+void testFlushDraw()
+{
+    auto result = OutsAnalyzer::outs(makeHand("As Ks"), makeHand("7s 2s 9d"));
+    assert(result.current == HandRank::HIGH_CARD);
+    assert(result.count(HandRank::FLUSH) == 9);
+    assert(result.count(HandRank::PAIR) == 6); // Any ace or king
+    assert(result.total() == 15);
+    std::cout << "✓ Nut flush draw\n";
+}
+
+void testOpenEnder()
+{
+    auto result = OutsAnalyzer::outs(makeHand("9h 8d"), makeHand("7c 6s 2h"));
+    assert(result.outs(HandRank::STRAIGHT) == maskOf("5c 5d 5h 5s Tc Td Th Ts"));
+    std::cout << "✓ Open-ended straight draw\n";
+}
+
+void testSetOuts()
+{
+    auto result = OutsAnalyzer::outs(makeHand("5h 5d"), makeHand("Ac Ks 2h"));
+    assert(result.current == HandRank::PAIR);
+    assert(result.outs(HandRank::THREE_OF_A_KIND) == maskOf("5c 5s"));
+
+    // Pairing the board gives every hand that pair: not an out
+    assert(result.count(HandRank::TWO_PAIR) == 0);
+    assert(result.total() == 2);
+    std::cout << "✓ Set outs\n";
+}
+
+void testStraightFlushDraw()
+{
+    // 8h completes both the flush and the straight: the evaluator decides
+    auto result = OutsAnalyzer::outs(makeHand("Jh Th"), makeHand("9h 7h 2c 3d"));
+    assert(result.outs(HandRank::STRAIGHT_FLUSH) == maskOf("8h"));
+    assert(result.count(HandRank::FLUSH) == 8);
+    assert(result.outs(HandRank::STRAIGHT) == maskOf("8c 8d 8s"));
+    std::cout << "✓ Straight flush draw\n";
+}
+
+// Evaluator-only reference on turn boards, where board + river is a hand
+void testTurnMatchesEvaluator()
+{
+    auto deck = Deck::getAllCardsVector();
+    uint32_t seed = 99;
+    for (int n = 0; n < 300; ++n)
+    {
+        std::vector<Card> dealt;
+        uint64_t used = 0;
+        while (dealt.size() < 6)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            const Card &card = deck[(seed >> 8) % 52];
+            if (used & (uint64_t(1) << card.getIndex()))
+                continue;
+            used |= uint64_t(1) << card.getIndex();
+            dealt.push_back(card);
+        }
+        std::vector<Card> hole(dealt.begin(), dealt.begin() + 2);
+        std::vector<Card> board(dealt.begin() + 2, dealt.end());
+
+        auto result = OutsAnalyzer::outs(hole, board);
+        HandRank current = HandEvaluator::evaluate(hole, board).rank;
+        assert(result.current == current);
+
+        for (const auto &card : deck)
+        {
+            if (used & (uint64_t(1) << card.getIndex()))
+                continue;
+            auto river = board;
+            river.push_back(card);
+            HandRank next = HandEvaluator::evaluate(hole, river).rank;
+            HandRank boardOnly = HandEvaluator::evaluate(river).rank;
+            // Pair-type improvements must pair a hole card's rank
+            bool pairsHole = card.getRank() == hole[0].getRank() || card.getRank() == hole[1].getRank();
+            bool expected = next > current && next > boardOnly &&
+                            (next > HandRank::TWO_PAIR || pairsHole);
+            uint64_t bit = uint64_t(1) << card.getIndex();
+            assert(((result.outs(next) & bit) != 0) == expected);
+            assert(((result.allOuts() & bit) != 0) == expected);
+        }
+    }
+    std::cout << "✓ Turn outs match evaluator\n";
+}
+
+void testNextCardEquity()
+{
+    auto hole = makeHand("As Ah");
+    auto villainHand = makeHand("Kh Kc");
+    auto board = makeHand("9s 4d 2c Ks");
+    Range villain;
+    villain.setWeight(villainHand[0], villainHand[1], 1.0f);
+
+    auto equity = OutsAnalyzer::nextCardEquity(hole, board, villain);
+    uint8_t hole1[2] = {hole[0].getIndex(), hole[1].getIndex()};
+    uint8_t hole2[2] = {villainHand[0].getIndex(), villainHand[1].getIndex()};
+    uint8_t turn[4];
+    for (size_t i = 0; i < 4; ++i)
+        turn[i] = board[i].getIndex();
+    double expected = BatchEvaluator::equity(hole1, hole2, turn, 4).equity();
+    assert(std::fabs(equity.current - expected) < 1e-4);
+
+    // The case ace rescues aces; a blank leaves them drawing dead
+    assert(equity.next[Card::fromString("Ad").getIndex()] == 1.0f);
+    assert(equity.next[Card::fromString("3h").getIndex()] == 0.0f);
+    assert(equity.change(Card::fromString("Ad").getIndex()) > 0.9f);
+    assert(equity.next[Card::fromString("Kh").getIndex()] == -1.0f);
+
+    // Flop: next-card equity averages every river after the turn
+    board.pop_back();
+    auto flop = OutsAnalyzer::nextCardEquity(hole, board, villain);
+    uint8_t flopTurn[4] = {board[0].getIndex(), board[1].getIndex(), board[2].getIndex(),
+                           Card::fromString("7h").getIndex()};
+    expected = BatchEvaluator::equity(hole1, hole2, flopTurn, 4).equity();
+    assert(std::fabs(flop.next[flopTurn[3]] - expected) < 1e-4);
+    std::cout << "✓ Next-card equity against a range\n";
+}
+
+// Equity against a range, enumerating each villain combo exactly
+double rangeEquity(const std::vector<Card> &hole, const std::vector<Card> &board,
+                   const Range &villain)
+{
+    uint8_t hero[2] = {hole[0].getIndex(), hole[1].getIndex()};
+    uint8_t cards[5];
+    for (size_t i = 0; i < board.size(); ++i)
+        cards[i] = board[i].getIndex();
+    uint64_t dead = Range::cardMask(hole) | Range::cardMask(board);
+
+    double sum = 0.0;
+    double weight = 0.0;
+    for (size_t combo = 0; combo < Range::NUM_COMBOS; ++combo)
+    {
+        auto [hi, lo] = Range::comboCards(combo);
+        if (villain[combo] <= 0.0f || (dead & ((uint64_t(1) << hi) | (uint64_t(1) << lo))))
+            continue;
+        uint8_t other[2] = {hi, lo};
+        sum += villain[combo] * BatchEvaluator::equity(hero, other, cards, board.size()).equity();
+        weight += villain[combo];
+    }
+    return sum / weight;
+}
+
+void testNextCardEquityWeighting()
+{
+    // Runouts block different amounts of the range: weight them by what is left
+    auto hole = makeHand("Qs Qh");
+    auto board = makeHand("Kd 7c 2s 3h");
+    auto villain = Range::parse("KK, AK, 77");
+
+    auto equity = OutsAnalyzer::nextCardEquity(hole, board, villain);
+    assert(std::fabs(equity.current - rangeEquity(hole, board, villain)) < 1e-4);
+
+    auto river = board;
+    river.push_back(Card::fromString("Ac"));
+    assert(std::fabs(equity.next[river[4].getIndex()] - rangeEquity(hole, river, villain)) < 1e-4);
+
+    board.pop_back();
+    auto flop = OutsAnalyzer::nextCardEquity(hole, board, villain);
+    assert(std::fabs(flop.current - rangeEquity(hole, board, villain)) < 1e-4);
+    auto turn = board;
+    turn.push_back(Card::fromString("Kh"));
+    assert(std::fabs(flop.next[turn[3].getIndex()] - rangeEquity(hole, turn, villain)) < 1e-4);
+    std::cout << "✓ Next-card equity weights runouts by villain weight\n";
+}
+
+int main()
+{
+    std::cout << "Running OutsAnalyzer tests...\n\n";
+
+    testFlushDraw();
+    testOpenEnder();
+    testSetOuts();
+    testStraightFlushDraw();
+    testTurnMatchesEvaluator();
+    testNextCardEquity();
+    testNextCardEquityWeighting();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "../game/Range.h"
+#include "../game/Card.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <string>
+
+using namespace poker;
+
+// Helper to create cards from string like "As Kh Qd Jc Ts"
+std::vector<Card> makeHand(const std::string &str)
+{
+    std::vector<Card> cards;
+    size_t i = 0;
+    while (i < str.length())
+    {
+        if (str[i] == ' ')
+        {
+            ++i;
+            continue;
+        }
+        cards.push_back(Card::fromString(str.substr(i, 2)));
+        i += 2;
+    }
+    return cards;
+}
+
+bool near(float a, float b)
+{
+    return std::fabs(a - b) < 1e-3f;
+}
+
+size_t countCombos(const Range &range)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < Range::NUM_COMBOS; ++i)
+    {
+        if (range[i] > 0.0f)
+            ++count;
+    }
+    return count;
+}
+
+void testComboOrdering()
+{
+    for (size_t i = 0; i < Range::NUM_COMBOS; ++i)
+    {
+        auto [hi, lo] = Range::comboCards(i);
+        assert(hi > lo);
+        assert(Range::comboIndex(hi, lo) == i);
+        assert(Range::comboIndex(Card::fromIndex(lo), Card::fromIndex(hi)) == i);
+    }
+    assert(Card::fromString("As").getIndex() == 51);
+    assert(Card::fromString("2c").getIndex() == 0);
+    std::cout << "✓ Combo ordering\n";
+}
+
+void testParse()
+{
+    assert(countCombos(Range::parse("AKs")) == 4);
+    assert(countCombos(Range::parse("AKo")) == 12);
+    assert(countCombos(Range::parse("AK")) == 16);
+    assert(countCombos(Range::parse("QQ+")) == 18);
+    assert(countCombos(Range::parse("22-44")) == 18);
+    assert(countCombos(Range::parse("T9s-76s")) == 16);
+    assert(countCombos(Range::parse("A2s+")) == 48);
+    assert(countCombos(Range::parse("A5s-A2s")) == 16);
+    assert(countCombos(Range::parse("AKs, QQ+, T9s-76s")) == 38);
+
+    auto range = Range::parse("AhKh, JJ:0.5");
+    assert(countCombos(range) == 7);
+    assert(range.weight(Card::fromString("Kh"), Card::fromString("Ah")) == 1.0f);
+    assert(range.weight(Card::fromString("Js"), Card::fromString("Jd")) == 0.5f);
+    assert(range.weight(Card::fromString("As"), Card::fromString("Ks")) == 0.0f);
+
+    for (const char *bad : {"AKx", "AAs", "XX", "AK-Q9", "AKs-76o", "AK:", "AsAs", "AA:nan", "AA:inf", "AA:-inf", "AA:1e39"})
+    {
+        bool threw = false;
+        try
+        {
+            Range::parse(bad);
+        }
+        catch (const std::invalid_argument &)
+        {
+            threw = true;
+        }
+        assert(threw);
+    }
+    std::cout << "✓ Range parsing\n";
+}
+
+void testNormalizeAndMultiply()
+{
+    auto range = Range::parse("AA, KK:0.5");
+    assert(near(range.sum(), 9.0f));
+    range.normalize();
+    assert(near(range.sum(), 1.0f));
+
+    auto strategy = Range::full();
+    strategy *= 0.25f;
+    range *= strategy;
+    assert(near(range.sum(), 0.25f));
+    std::cout << "✓ Normalize and multiply\n";
+}
+
+void testRemoveBlocked()
+{
+    auto range = Range::full();
+    range.removeBlocked(makeHand("As Kd 7c"));
+    assert(countCombos(range) == 1176); // C(49, 2)
+    assert(range.weight(Card::fromString("As"), Card::fromString("Ah")) == 0.0f);
+    assert(range.weight(Card::fromString("Ah"), Card::fromString("Ad")) == 1.0f);
+    std::cout << "✓ Remove blocked combos\n";
+}
+
+void testCardReach()
+{
+    auto range = Range::full();
+    auto reach = range.cardReach();
+    for (float r : reach)
+        assert(near(r, 51.0f));
+
+    // Compatible combos with a given hand: C(50, 2)
+    auto compatible = range.compatibleReach();
+    for (size_t i = 0; i < Range::NUM_COMBOS; ++i)
+        assert(near(compatible[i], 1225.0f));
+
+    // Against AA, AsKs only meets the three AA combos without the As
+    auto aces = Range::parse("AA");
+    auto vsAces = aces.compatibleReach();
+    assert(near(vsAces[Range::comboIndex(Card::fromString("As"), Card::fromString("Ks"))], 3.0f));
+    assert(near(vsAces[Range::comboIndex(Card::fromString("Qs"), Card::fromString("Ks"))], 6.0f));
+    std::cout << "✓ Card reach and blocker correction\n";
+}
+
+int main()
+{
+    std::cout << "Running Range tests...\n\n";
+
+    testComboOrdering();
+    testParse();
+    testNormalizeAndMultiply();
+    testRemoveBlocked();
+    testCardReach();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,254 @@
+#include "../game/ShardedSolve.h"
+#include "../game/BatchEvaluator.h"
+#include "../game/Range.h"
+#include "../game/Card.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+using namespace poker;
+
+// Helper to create cards from string like "As Kh Qd Jc Ts"
+std::vector<Card> makeHand(const std::string &str)
+{
+    std::vector<Card> cards;
+    size_t i = 0;
+    while (i < str.length())
+    {
+        if (str[i] == ' ')
+        {
+            ++i;
+            continue;
+        }
+        cards.push_back(Card::fromString(str.substr(i, 2)));
+        i += 2;
+    }
+    return cards;
+}
+
+void testMergeAcrossProcesses()
+{
+    ShardedSolveConfig config;
+    config.board = makeHand("Ks 9h 4d");
+    config.workers = 3;
+    config.iterations = 4;
+    config.boundarySize = 2;
+    config.regretSize = 3;
+    config.checkpointPath = "/tmp/ninja_sharded_solve_test.ckpt";
+
+    ShardedSolver solver(config);
+    pid_t coordinator = getpid();
+    auto checkpoint = solver.run([coordinator](const SubtreeContext &context)
+                                 {
+        context.boundary[0] = static_cast<float>(context.shard);
+        context.boundary[1] = static_cast<float>(context.iteration);
+        context.regretDelta[0] += 1.0f;
+        context.regretDelta[1] += context.card;
+        context.regretDelta[2] += getpid() != coordinator ? 1.0f : 0.0f; });
+
+    const auto &cards = solver.subtreeCards();
+    assert(cards.size() == 49);
+    float cardSum = 0.0f;
+    for (size_t s = 0; s < cards.size(); ++s)
+    {
+        cardSum += cards[s];
+        assert(checkpoint.boundary[2 * s] == static_cast<float>(solver.ownerOf(s)));
+        assert(checkpoint.boundary[2 * s + 1] == 3.0f);
+    }
+    assert(checkpoint.iteration == 4);
+    assert(checkpoint.regrets[0] == 4 * 49.0f);
+    assert(checkpoint.regrets[1] == 4 * cardSum);
+    assert(checkpoint.regrets[2] == 4 * 49.0f); // Every subtree ran in a worker
+
+    auto loaded = SolveCheckpoint::load(config.checkpointPath);
+    assert(loaded.iteration == checkpoint.iteration);
+    assert(loaded.cards == checkpoint.cards);
+    assert(loaded.boundary == checkpoint.boundary);
+    assert(loaded.regrets == checkpoint.regrets);
+    std::remove(config.checkpointPath.c_str());
+    std::cout << "✓ Regret deltas merge across worker processes\n";
+}
+
+void testShowdownBoundary()
+{
+    auto board = makeHand("9s 4d 2c");
+    auto hero = makeHand("As Ah");
+    auto villain = makeHand("Kh Kc");
+
+    ShardedSolveConfig config;
+    config.board = board;
+    config.workers = 4;
+    config.boundarySize = Range::NUM_COMBOS;
+
+    Range heroRange;
+    heroRange.setWeight(hero[0], hero[1], 1.0f);
+    Range villainRange;
+    villainRange.setWeight(villain[0], villain[1], 1.0f);
+
+    ShardedSolver solver(config);
+    auto checkpoint = solver.run(showdownBoundaryTask(board, heroRange, villainRange));
+
+    uint8_t hole1[2] = {hero[0].getIndex(), hero[1].getIndex()};
+    uint8_t hole2[2] = {villain[0].getIndex(), villain[1].getIndex()};
+    size_t combo = Range::comboIndex(hero[0], hero[1]);
+    const auto &cards = solver.subtreeCards();
+    for (size_t s = 0; s < cards.size(); ++s)
+    {
+        float value = checkpoint.boundary[s * Range::NUM_COMBOS + combo];
+        uint8_t turn[4] = {board[0].getIndex(), board[1].getIndex(), board[2].getIndex(), cards[s]};
+        if (cards[s] == hole1[0] || cards[s] == hole1[1])
+        {
+            assert(value == -1.0f);
+            continue;
+        }
+        if (cards[s] == hole2[0] || cards[s] == hole2[1])
+            continue;
+        double expected = BatchEvaluator::equity(hole1, hole2, turn, 4).equity();
+        assert(std::fabs(value - expected) < 1e-4);
+    }
+    std::cout << "✓ Check-down boundary values per turn card\n";
+}
+
+void testShowdownBoundaryRange()
+{
+    // Villain weight left after each river differs: boundary values must be
+    // per-combo equity weighted by villain weight, not an average of ratios
+    auto board = makeHand("Kd 7c 2s");
+    auto hero = makeHand("Qs Qh");
+    auto villain = Range::parse("KK, AK, 77");
+
+    ShardedSolveConfig config;
+    config.board = board;
+    config.workers = 2;
+    config.boundarySize = Range::NUM_COMBOS;
+
+    Range heroRange;
+    heroRange.setWeight(hero[0], hero[1], 1.0f);
+    ShardedSolver solver(config);
+    auto checkpoint = solver.run(showdownBoundaryTask(board, heroRange, villain));
+
+    uint8_t hole1[2] = {hero[0].getIndex(), hero[1].getIndex()};
+    size_t combo = Range::comboIndex(hero[0], hero[1]);
+    const auto &cards = solver.subtreeCards();
+    for (size_t s = 0; s < cards.size(); s += 7)
+    {
+        if (cards[s] == hole1[0] || cards[s] == hole1[1])
+            continue;
+        uint8_t turn[4] = {board[0].getIndex(), board[1].getIndex(), board[2].getIndex(), cards[s]};
+        uint64_t dead = Range::cardMask(board) | Range::cardMask(hero) | (uint64_t(1) << cards[s]);
+
+        double sum = 0.0;
+        double weight = 0.0;
+        for (size_t c = 0; c < Range::NUM_COMBOS; ++c)
+        {
+            auto [hi, lo] = Range::comboCards(c);
+            if (villain[c] <= 0.0f || (dead & ((uint64_t(1) << hi) | (uint64_t(1) << lo))))
+                continue;
+            uint8_t hole2[2] = {hi, lo};
+            sum += villain[c] * BatchEvaluator::equity(hole1, hole2, turn, 4).equity();
+            weight += villain[c];
+        }
+        float value = checkpoint.boundary[s * Range::NUM_COMBOS + combo];
+        assert(std::fabs(value - sum / weight) < 1e-4);
+    }
+    std::cout << "✓ Check-down boundary weights runouts by villain weight\n";
+}
+
+void testShowdownBoundaryTooSmall()
+{
+    auto board = makeHand("Kd 7c 2s 3h");
+    ShardedSolveConfig config;
+    config.board = board;
+    config.workers = 2;
+    config.boundarySize = 16;
+
+    ShardedSolver solver(config);
+    bool threw = false;
+    try
+    {
+        solver.run(showdownBoundaryTask(board, Range::full(), Range::full()));
+    }
+    catch (const std::runtime_error &e)
+    {
+        threw = std::string(e.what()).find("boundarySize") != std::string::npos;
+    }
+    assert(threw);
+    std::cout << "✓ Check-down boundary rejects a short boundary\n";
+}
+
+void testWorkerFailure()
+{
+    ShardedSolveConfig config;
+    config.board = makeHand("Ks 9h 4d 2c");
+    config.workers = 2;
+    config.iterations = 2;
+
+    ShardedSolver solver(config);
+    bool threw = false;
+    try
+    {
+        solver.run([](const SubtreeContext &context)
+                   {
+            if (context.iteration == 1 && context.shard == 1)
+                throw std::runtime_error("injected failure"); });
+    }
+    catch (const std::runtime_error &e)
+    {
+        std::string message = e.what();
+        threw = message.find("iteration 1") != std::string::npos &&
+                message.find("shard 1: injected failure") != std::string::npos;
+    }
+    assert(threw);
+    std::cout << "✓ Worker failure is reported\n";
+}
+
+void testWorkerDiesBetweenIterations()
+{
+    // Shard 1 finishes iteration 0 and is killed while parked; handing it the
+    // next iteration must fail the solve rather than raise SIGPIPE
+    ShardedSolveConfig config;
+    config.board = makeHand("Ks 9h 4d 2c");
+    config.workers = 2;
+    config.iterations = 2;
+
+    ShardedSolver solver(config);
+    bool threw = false;
+    try
+    {
+        solver.run([](const SubtreeContext &context)
+                   {
+            static bool armed = false;
+            if (context.iteration != 0 || armed)
+                return;
+            armed = true;
+            if (context.shard == 1)
+                alarm(1);
+            else
+                sleep(2); });
+    }
+    catch (const std::runtime_error &e)
+    {
+        threw = std::string(e.what()).find("shard 1") != std::string::npos;
+    }
+    assert(threw);
+    std::cout << "✓ Worker death between iterations is reported\n";
+}
+
+int main()
+{
+    std::cout << "Running ShardedSolver tests...\n\n";
+
+    testMergeAcrossProcesses();
+    testShowdownBoundary();
+    testShowdownBoundaryRange();
+    testShowdownBoundaryTooSmall();
+    testWorkerFailure();
+    testWorkerDiesBetweenIterations();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}
@@ -0,0 +1,201 @@
+#include "../game/VariantEvaluation.h"
+#include "../game/HandEvaluation.h"
+#include "../game/Deck.h"
+#include <iostream>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+using namespace poker;
+
+// Helper to create cards from string like "As Kh Qd Jc Ts"
+std::vector<Card> makeHand(const std::string &str)
+{
+    std::vector<Card> cards;
+    size_t i = 0;
+    while (i < str.length())
+    {
+        if (str[i] == ' ')
+        {
+            ++i;
+            continue;
+        }
+        cards.push_back(Card::fromString(str.substr(i, 2)));
+        i += 2;
+    }
+    return cards;
+}
+
+// Deterministic shuffle so failures are reproducible
+std::vector<Card> dealCards(std::vector<Card> deck, size_t count, uint32_t &seed)
+{
+    std::vector<Card> dealt;
+    for (size_t i = 0; i < count; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        size_t j = i + (seed >> 8) % (deck.size() - i);
+        std::swap(deck[i], deck[j]);
+        dealt.push_back(deck[i]);
+    }
+    return dealt;
+}
+
+bool sameResult(const HandResult &a, const HandResult &b)
+{
+    return a.rank == b.rank && a.tiebreakers == b.tiebreakers;
+}
+
+void testHoldemMatchesReference()
+{
+    uint32_t seed = 12345;
+    auto deck = Deck::getAllCardsVector();
+    for (int n = 0; n < 20000; ++n)
+    {
+        auto cards = dealCards(deck, 5 + n % 3, seed);
+        std::vector<Card> hole(cards.begin(), cards.begin() + 2);
+        std::vector<Card> board(cards.begin() + 2, cards.end());
+        assert(sameResult(HoldemEvaluator::evaluate(hole, board),
+                          HandEvaluator::evaluate(cards)));
+    }
+    std::cout << "✓ Hold'em matches reference evaluator\n";
+}
+
+void testHoldemCategories()
+{
+    auto result = HoldemEvaluator::evaluate(makeHand("As Ks"), makeHand("Qs Js Ts 2d 3h"));
+    assert(result.rank == HandRank::ROYAL_FLUSH);
+
+    result = HoldemEvaluator::evaluate(makeHand("As 2d"), makeHand("3h 4c 5s"));
+    assert(result.rank == HandRank::STRAIGHT);
+    assert(result.tiebreakers[0] == 5);
+
+    result = HoldemEvaluator::evaluate(makeHand("As Ah"), makeHand("Ad Kc Ks Kh 2d"));
+    assert(result.rank == HandRank::FULL_HOUSE);
+    assert(result.tiebreakers[0] == 14);
+    assert(result.tiebreakers[1] == 13);
+    std::cout << "✓ Hold'em categories\n";
+}
+
+void testShortDeckFlushBeatsFullHouse()
+{
+    auto flush = makeHand("As 7s");
+    auto fullHouse = makeHand("Kd Kc");
+    auto board = makeHand("Ks 9s 8s 9d Th");
+
+    assert(ShortDeckEvaluator::evaluate(flush, board).rank == HandRank::FLUSH);
+    assert(ShortDeckEvaluator::evaluate(fullHouse, board).rank == HandRank::FULL_HOUSE);
+    assert(ShortDeckEvaluator::compare(flush, fullHouse, board) == CompareResult::HAND1_WINS);
+    assert(HoldemEvaluator::compare(flush, fullHouse, board) == CompareResult::HAND2_WINS);
+    std::cout << "✓ Short-deck flush beats full house\n";
+}
+
+void testShortDeckWheel()
+{
+    auto result = ShortDeckEvaluator::evaluate(makeHand("As 6d"), makeHand("7h 8c 9s Kd Kh"));
+    assert(result.rank == HandRank::STRAIGHT);
+    assert(result.tiebreakers[0] == 9);
+
+    // 6-7-8-9-T beats the A-6-7-8-9 wheel
+    assert(ShortDeckEvaluator::compare(makeHand("6s Ts"), makeHand("As 6d"),
+                                       makeHand("7h 8c 9s Kd Qh")) == CompareResult::HAND1_WINS);
+
+    // Deuces are not in the deck
+    auto board = makeHand("7h 8c 9s Kd 2h");
+    bool threw = false;
+    try
+    {
+        ShortDeckEvaluator::evaluate(makeHand("As 6d"), board);
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    assert(threw);
+    assert(ShortDeckEvaluator::deck().size() == 36);
+    std::cout << "✓ Short-deck ace-low straight and deck\n";
+}
+
+void testOmahaUsesExactlyTwo()
+{
+    // Four spades in hand, one on board: no flush
+    auto result = OmahaEvaluator::evaluate(makeHand("As Ks Qs Js"), makeHand("2s 7d 8c 3h 9d"));
+    assert(result.rank == HandRank::HIGH_CARD);
+
+    // Four-flush board, one spade in hand: no flush
+    result = OmahaEvaluator::evaluate(makeHand("As Kd Qc 2h"), makeHand("3s 7s 8s 9s Jd"));
+    assert(result.rank != HandRank::FLUSH);
+
+    // Trips on board with a pocket pair is a full house, not quads
+    result = OmahaEvaluator::evaluate(makeHand("Kd Kh 2c 3c"), makeHand("Ks Qd Qh Qc 7s"));
+    assert(result.rank == HandRank::FULL_HOUSE);
+    assert(result.tiebreakers[0] == 13);
+    std::cout << "✓ Omaha uses exactly two hole cards\n";
+}
+
+bool rejects(uint32_t (*score)(const std::vector<Card> &, const std::vector<Card> &),
+             const std::string &hole, const std::string &board)
+{
+    try
+    {
+        score(makeHand(hole), makeHand(board));
+    }
+    catch (const std::invalid_argument &)
+    {
+        return true;
+    }
+    return false;
+}
+
+void testHoleCardCount()
+{
+    assert(rejects(OmahaEvaluator::score, "As Ks", "2s 7d 8c 3h 9d"));
+    assert(rejects(OmahaEvaluator::score, "As Ks Qs Js Ts", "2s 7d 8c 3h 9d"));
+    assert(rejects(HoldemEvaluator::score, "As Ks Qs Js", "2s 7d 8c 3h 9d"));
+    assert(rejects(HoldemEvaluator::score, "As", "Ks 2s 7d 8c 3h 9d"));
+    assert(rejects(ShortDeckEvaluator::score, "As Ks Qs", "Js 7d 8c"));
+    assert(!rejects(HoldemEvaluator::score, "As Ks", "2s 7d 8c"));
+    std::cout << "✓ Hole card count enforced\n";
+}
+
+void testOmahaMatchesBruteForce()
+{
+    uint32_t seed = 777;
+    auto deck = Deck::getAllCardsVector();
+    for (int n = 0; n < 2000; ++n)
+    {
+        auto cards = dealCards(deck, 9, seed);
+        std::vector<Card> hole(cards.begin(), cards.begin() + 4);
+        std::vector<Card> board(cards.begin() + 4, cards.end());
+
+        HandResult best = {HandRank::HIGH_CARD, {0}};
+        for (size_t i = 0; i < 4; ++i)
+            for (size_t j = i + 1; j < 4; ++j)
+                for (size_t a = 0; a < 5; ++a)
+                    for (size_t b = a + 1; b < 5; ++b)
+                        for (size_t c = b + 1; c < 5; ++c)
+                        {
+                            auto result = HandEvaluator::evaluate(
+                                {hole[i], hole[j], board[a], board[b], board[c]});
+                            if (result > best)
+                                best = result;
+                        }
+        assert(sameResult(OmahaEvaluator::evaluate(hole, board), best));
+    }
+    std::cout << "✓ Omaha matches brute force\n";
+}
+
+int main()
+{
+    std::cout << "Running VariantEvaluator tests...\n\n";
+
+    testHoldemMatchesReference();
+    testHoldemCategories();
+    testShortDeckFlushBeatsFullHouse();
+    testShortDeckWheel();
+    testOmahaUsesExactlyTwo();
+    testHoleCardCount();
+    testOmahaMatchesBruteForce();
+
+    std::cout << "\nAll tests passed!\n";
+    return 0;
+}